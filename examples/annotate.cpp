@@ -0,0 +1,63 @@
+#include <fstream>
+#include <iostream>
+#include <libataxx/analysis.hpp>
+#include <libataxx/pgn.hpp>
+#include <string>
+#include <thread>
+
+// Adds search scores as comments to every move of every game in a PGN
+int main(int argc, char **argv) {
+    std::string input;
+    std::string output;
+    libataxx::analysis::Options options;
+    options.limits.depth = 8;
+    options.threads = std::max(1U, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-depth" && i + 1 < argc) {
+            options.limits.depth = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-nodes" && i + 1 < argc) {
+            options.limits.depth = 0;
+            options.limits.nodes = std::stoull(argv[++i]);
+        } else if (key == "-multipv" && i + 1 < argc) {
+            options.limits.multipv = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-threads" && i + 1 < argc) {
+            options.threads = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-hash" && i + 1 < argc) {
+            options.hash_mb = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (key[0] != '-' && input.empty()) {
+            input = key;
+        } else {
+            std::cout << "Usage: annotate games.pgn [-o out.pgn] [-depth n|-nodes n] [-multipv n] [-threads n]"
+                      << " [-hash mb]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::ifstream in{input};
+    if (!in) {
+        std::cerr << "Could not open " << input << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+    }
+    auto &out = output.empty() ? std::cout : file;
+
+    try {
+        while (auto game = libataxx::pgn::read(in)) {
+            libataxx::analysis::annotate(*game, options);
+            out << *game << std::flush;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <libataxx/analysis.hpp>
+#include <libataxx/position.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+// Searches every position in a FEN file and writes one line per position in
+// file order, "fen;bestmove;score;depth;nodes;ms"
+// With a checkpoint file an interrupted run picks up where it left off, the
+// output is cut back to the last checkpoint and appended to
+
+// EPD opcodes after the FEN are ignored, as are empty lines and comments
+[[nodiscard]] std::vector<libataxx::Position> load(const std::string &path, std::vector<std::string> &fens) {
+    std::ifstream fs{path};
+    if (!fs.is_open()) {
+        throw std::runtime_error("Could not open " + path);
+    }
+
+    std::vector<libataxx::Position> positions;
+    std::string line;
+    for (int n = 1; std::getline(fs, line); ++n) {
+        line = line.substr(0, line.find(';'));
+        while (!line.empty() && (line.back() == ' ' || line.back() == '\r')) {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        const auto pos = libataxx::Position::from_fen(line);
+        if (!pos) {
+            throw std::invalid_argument("Invalid FEN on line " + std::to_string(n) + " " + line);
+        }
+        positions.push_back(*pos);
+        fens.push_back(line);
+    }
+
+    return positions;
+}
+
+int main(int argc, char **argv) {
+    std::string input;
+    std::string output;
+    std::string checkpoint_path;
+    libataxx::analysis::Options options;
+    options.limits.depth = 8;
+    options.threads = std::max(1U, std::thread::hardware_concurrency());
+    auto interval = seconds(5);
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-depth" && i + 1 < argc) {
+            options.limits.depth = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-nodes" && i + 1 < argc) {
+            options.limits.depth = 0;
+            options.limits.nodes = std::stoull(argv[++i]);
+        } else if (key == "-threads" && i + 1 < argc) {
+            options.threads = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-hash" && i + 1 < argc) {
+            options.hash_mb = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-clear") {
+            options.clear = true;
+        } else if (key == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (key == "-checkpoint" && i + 1 < argc) {
+            checkpoint_path = argv[++i];
+        } else if (key == "-interval" && i + 1 < argc) {
+            interval = seconds(std::max(0, std::stoi(argv[++i])));
+        } else if (key[0] != '-' && input.empty()) {
+            input = key;
+        } else {
+            std::cout << "Usage: batch fens.txt [-o out.txt] [-checkpoint file] [-interval s] [-depth n|-nodes n]"
+                      << " [-threads n] [-hash mb] [-clear]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!checkpoint_path.empty() && output.empty()) {
+        std::cerr << "A checkpoint needs an output file" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> fens;
+    std::vector<libataxx::Position> positions;
+    libataxx::analysis::Checkpoint checkpoint;
+    try {
+        positions = load(input, fens);
+        if (!checkpoint_path.empty()) {
+            checkpoint = libataxx::analysis::read_checkpoint(checkpoint_path);
+        }
+        if (checkpoint.positions > positions.size()) {
+            throw std::runtime_error("Checkpoint is past the end of " + input);
+        }
+
+        // Anything written after the last checkpoint gets written again
+        if (checkpoint.positions > 0) {
+            if (!std::filesystem::exists(output) || std::filesystem::file_size(output) < checkpoint.bytes) {
+                throw std::runtime_error("Output " + output + " is shorter than the checkpoint");
+            }
+            std::filesystem::resize_file(output, checkpoint.bytes);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output, checkpoint.positions > 0 ? std::ios::app : std::ios::trunc);
+        if (!file) {
+            std::cerr << "Could not open " << output << std::endl;
+            return 1;
+        }
+    }
+    auto &out = output.empty() ? std::cout : file;
+
+    std::cerr << "Positions: " << positions.size() << std::endl;
+    std::cerr << "Resuming from: " << checkpoint.positions << std::endl;
+    std::cerr << "Threads: " << options.threads << std::endl;
+
+    std::uint64_t total_nodes = 0;
+    const auto t0 = steady_clock::now();
+    auto last_checkpoint = t0;
+
+    const auto save = [&]() {
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Could not write " + output);
+        }
+        if (!checkpoint_path.empty()) {
+            libataxx::analysis::write_checkpoint(checkpoint_path, checkpoint);
+        }
+    };
+
+    try {
+        libataxx::analysis::analyse(
+            positions,
+            options,
+            [&](const std::size_t index, const libataxx::search::Result &result, const milliseconds time) {
+                const auto line = fens[index] + ";" + static_cast<std::string>(result.bestmove) + ";" +
+                                  std::to_string(result.score) + ";" + std::to_string(result.depth) + ";" +
+                                  std::to_string(result.nodes) + ";" + std::to_string(time.count()) + "\n";
+                out << line;
+
+                checkpoint.positions = index + 1;
+                checkpoint.bytes += line.size();
+                total_nodes += result.nodes;
+
+                const auto now = steady_clock::now();
+                if (now - last_checkpoint >= interval) {
+                    save();
+                    last_checkpoint = now;
+                }
+            },
+            checkpoint.positions);
+        save();
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    const auto ms = std::max<std::int64_t>(1, duration_cast<milliseconds>(steady_clock::now() - t0).count());
+    std::cerr << "Nodes: " << total_nodes << std::endl;
+    std::cerr << "Time: " << ms << "ms" << std::endl;
+    std::cerr << "NPS: " << total_nodes * 1000 / ms << std::endl;
+
+    return 0;
+}
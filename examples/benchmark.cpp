@@ -4,29 +4,8 @@
 #include <iostream>
 #include <libataxx/libataxx.hpp>
 #include <string>
-
-const std::array<std::string, 20> fens = {
-    "x5o/7/7/7/7/7/o5x x 0 1",
-    "x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1",
-    "x5o/7/3-3/2-1-2/3-3/7/o5x x 0 1",
-    "x2-2o/3-3/2---2/7/2---2/3-3/o2-2x x 0 1",
-    "x2-2o/3-3/7/--3--/7/3-3/o2-2x x 0 1",
-    "x1-1-1o/2-1-2/2-1-2/7/2-1-2/2-1-2/o1-1-1x x 0 1",
-    "x5o/7/2-1-2/3-3/2-1-2/7/o5x x 0 1",
-    "x5o/7/3-3/2---2/3-3/7/o5x x 0 1",
-    "x5o/2-1-2/1-3-1/7/1-3-1/2-1-2/o5x x 0 1",
-    "x5o/1-3-1/2-1-2/7/2-1-2/1-3-1/o5x x 0 1",
-    "x-1-1-o/-1-1-1-/1-1-1-1/-1-1-1-/1-1-1-1/-1-1-1-/o-1-1-x x 0 1",
-    "x-1-1-o/1-1-1-1/1-1-1-1/1-1-1-1/1-1-1-1/1-1-1-1/o-1-1-x x 0 1",
-    "x1-1-1o/2-1-2/-------/2-1-2/-------/2-1-2/o1-1-1x x 0 1",
-    "x5o/1-----1/1-3-1/1-1-1-1/1-3-1/1-----1/o5x x 0 1",
-    "x-1-1-o/1-1-1-1/-1-1-1-/-1-1-1-/-1-1-1-/1-1-1-1/o-1-1-x/ x 0 1",
-    "x5o/1--1--1/1--1--1/7/1--1--1/1--1--1/o5x x 0 1",
-    "x-3-o/1-1-1-1/1-1-1-1/3-3/1-1-1-1/1-1-1-1/o-3-x x 0 1",
-    "x2-2o/3-3/3-3/-------/3-3/3-3/o2-2x x 0 1",
-    "x2-2o/2-1-2/1-3-1/-2-2-/1-3-1/2-1-2/o2-2x x 0 1",
-    "x5o/6-/1-4-/-3--1/2-4/7/o-3-x x 0 1",
-};
+#include "fens.hpp"
+#include "perf_counters.hpp"
 
 [[nodiscard]] auto format_ms(const std::chrono::microseconds micro) noexcept -> std::string {
     const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(micro).count();
@@ -39,6 +18,14 @@ int main(int argc, char **argv) {
     int depth = 1;
     auto total_time = std::chrono::microseconds(0);
     std::uint64_t total_nodes = 0;
+    bool counters = false;
+
+    // Hardware counters are optional and come first
+    if (argc > 1 && std::string(argv[1]) == "-counters") {
+        counters = true;
+        argv++;
+        argc--;
+    }
 
     // Get depth
     if (argc > 1) {
@@ -46,16 +33,29 @@ int main(int argc, char **argv) {
         depth = std::max(1, depth);
     }
 
+    PerfCounters perf;
+    if (counters && !perf.available()) {
+        std::cout << "Hardware counters unavailable" << std::endl;
+        counters = false;
+    }
+    std::array<std::uint64_t, num_counters> totals = {};
+    std::array<bool, num_counters> missing = {};
+
     // Print chart title
     std::cout << "Pos       Nodes       ΣNodes     Time     ΣTime   Mnps  ΣMnps  FEN\n";
 
-    for (std::size_t i = 0; i < fens.size(); ++i) {
-        const auto pos = libataxx::Position(fens.at(i));
+    for (std::size_t i = 0; i < benchmark_fens.size(); ++i) {
+        const auto pos = libataxx::Position(benchmark_fens.at(i));
 
         // Perft
+        CounterSample sample;
         const auto t0 = std::chrono::steady_clock::now();
-        const auto nodes = pos.perft(depth);
+        const auto nodes = counters ? perf.measure([&]() { return pos.perft(depth); }, sample) : pos.perft(depth);
         const auto t1 = std::chrono::steady_clock::now();
+        for (std::size_t j = 0; j < num_counters; ++j) {
+            totals[j] += sample.values[j].value_or(0);
+            missing[j] = missing[j] || !sample.values[j];
+        }
         const auto dt = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
 
         total_time += dt;
@@ -74,7 +74,19 @@ int main(int argc, char **argv) {
         std::cout << std::setw(7) << mnps;
         std::cout << std::setw(7) << total_mnps;
         std::cout << std::left;
-        std::cout << "  " << fens.at(i);
+        std::cout << "  " << benchmark_fens.at(i);
+        std::cout << "\n";
+    }
+
+    if (counters) {
+        CounterSample total;
+        for (std::size_t j = 0; j < num_counters; ++j) {
+            if (!missing[j]) {
+                total.values[j] = totals[j];
+            }
+        }
+        std::cout << "\n";
+        print_ratios(std::cout, total, total_nodes);
         std::cout << "\n";
     }
 
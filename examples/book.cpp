@@ -0,0 +1,104 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <libataxx/book.hpp>
+#include <libataxx/position.hpp>
+#include <string>
+
+using namespace std::chrono;
+
+int build(int argc, char **argv) {
+    libataxx::book::BuilderOptions options;
+    std::uint32_t min_games = 1;
+
+    int idx = 2;
+    for (; idx < argc && argv[idx][0] == '-'; ++idx) {
+        const std::string key = argv[idx];
+        if (key == "-symmetric") {
+            options.symmetric = true;
+        } else if (key == "-plies" && idx + 1 < argc) {
+            options.max_ply = std::stoi(argv[++idx]);
+        } else if (key == "-min" && idx + 1 < argc) {
+            min_games = std::stoul(argv[++idx]);
+        } else {
+            std::cerr << "Unknown option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    if (idx >= argc) {
+        std::cerr << "Missing output file" << std::endl;
+        return 1;
+    }
+
+    const std::string out = argv[idx];
+    libataxx::book::Builder builder{options};
+
+    for (int i = idx + 1; i < argc; ++i) {
+        const std::string path = argv[i];
+        const bool is_pgn = path.size() >= 4 && path.substr(path.size() - 4) == ".pgn";
+        std::ifstream fs(path, std::ios::binary);
+        if (!fs.is_open()) {
+            std::cerr << "Could not open " << path << std::endl;
+            return 1;
+        }
+
+        if (is_pgn) {
+            builder.add_pgn(fs);
+        } else {
+            builder.add_binpack(fs);
+        }
+    }
+
+    std::ofstream fs(out, std::ios::binary);
+    builder.write(fs, min_games);
+    std::cout << "Entries: " << builder.size() << std::endl;
+
+    return 0;
+}
+
+int probe(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << "Missing book or FEN" << std::endl;
+        return 1;
+    }
+
+    const auto t0 = steady_clock::now();
+    const libataxx::book::Book book{argv[2]};
+    const auto pos = libataxx::Position{argv[3]};
+    const auto moves = book.probe(pos);
+    const auto t1 = steady_clock::now();
+
+    for (const auto &move : moves) {
+        std::cout << static_cast<std::string>(move.move);
+        std::cout << " games " << move.games;
+        std::cout << " wins " << move.wins;
+        std::cout << " draws " << move.draws;
+        std::cout << " losses " << move.losses();
+        std::cout << " score " << move.score() << std::endl;
+    }
+    std::cout << "Time: " << duration_cast<microseconds>(t1 - t0).count() << "us" << std::endl;
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+
+    try {
+        if (mode == "build") {
+            return build(argc, argv);
+        }
+        if (mode == "probe") {
+            return probe(argc, argv);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  book build [-symmetric] [-plies n] [-min games] output.book input.pgn|input.binpack..." << std::endl;
+    std::cout << "  book probe input.book fen" << std::endl;
+    return 1;
+}
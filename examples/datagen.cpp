@@ -0,0 +1,258 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <libataxx/binpack.hpp>
+#include <libataxx/mcts.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/search.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "fens.hpp"
+#include "queue.hpp"
+
+using namespace std::chrono;
+
+struct Options {
+    int threads = std::max(1U, std::thread::hardware_concurrency());
+    int games = 100;
+    std::string out = "data.binpack";
+    std::string player = "search";
+    int depth = 4;
+    std::uint64_t nodes = 1000;
+    int plies = 8;
+    std::string openings = "benchmark";
+    std::uint64_t seed = 0;
+};
+
+class Player {
+   public:
+    virtual ~Player() = default;
+
+    // The move to play and its score from the side to move's point of view
+    [[nodiscard]] virtual std::pair<libataxx::Move, int> play(const libataxx::Position &pos) = 0;
+};
+
+class RandomPlayer : public Player {
+   public:
+    explicit RandomPlayer(const std::uint64_t seed) : rng_{seed} {
+    }
+
+    [[nodiscard]] std::pair<libataxx::Move, int> play(const libataxx::Position &pos) override {
+        libataxx::Move moves[libataxx::max_moves];
+        const int num_moves = pos.legal_moves(moves);
+        return {moves[rng_() % num_moves], libataxx::search::evaluate(pos)};
+    }
+
+   private:
+    std::mt19937_64 rng_;
+};
+
+class SearchPlayer : public Player {
+   public:
+    explicit SearchPlayer(const int depth) : search_{4} {
+        limits_.depth = depth;
+    }
+
+    [[nodiscard]] std::pair<libataxx::Move, int> play(const libataxx::Position &pos) override {
+        const auto result = search_.go(pos, limits_);
+        return {result.bestmove, result.score};
+    }
+
+   private:
+    libataxx::search::Search search_;
+    libataxx::search::Limits limits_;
+};
+
+class MCTSPlayer : public Player {
+   public:
+    explicit MCTSPlayer(const std::uint64_t nodes) {
+        limits_.nodes = nodes;
+    }
+
+    [[nodiscard]] std::pair<libataxx::Move, int> play(const libataxx::Position &pos) override {
+        const auto result = mcts_.go(pos, limits_);
+        return {result.bestmove, result.score};
+    }
+
+   private:
+    libataxx::mcts::MCTS mcts_;
+    libataxx::search::Limits limits_;
+};
+
+[[nodiscard]] std::unique_ptr<Player> make_player(const Options &options, const std::uint64_t seed) {
+    if (options.player == "random") {
+        return std::make_unique<RandomPlayer>(seed);
+    }
+    if (options.player == "mcts") {
+        return std::make_unique<MCTSPlayer>(options.nodes);
+    }
+    return std::make_unique<SearchPlayer>(options.depth);
+}
+
+using Game = std::vector<libataxx::binpack::TrainingEntry>;
+
+[[nodiscard]] libataxx::Position random_opening(const Options &options, std::mt19937_64 &rng) {
+    for (;;) {
+        auto pos = libataxx::Position{"startpos"};
+        if (options.openings == "benchmark") {
+            pos.set_fen(benchmark_fens.at(rng() % benchmark_fens.size()));
+        }
+
+        libataxx::Move moves[libataxx::max_moves];
+        for (int i = 0; i < options.plies && !pos.is_gameover(); ++i) {
+            const int num_moves = pos.legal_moves(moves);
+            pos.makemove(moves[rng() % num_moves]);
+        }
+
+        if (!pos.is_gameover()) {
+            return pos;
+        }
+    }
+}
+
+void worker(const Options &options,
+            const int id,
+            std::atomic<int> &games_started,
+            Queue<Game> &queue,
+            std::atomic<int> &running) {
+    std::mt19937_64 rng(options.seed + id);
+    auto player = make_player(options, options.seed + id);
+
+    while (games_started++ < options.games) {
+        auto pos = random_opening(options, rng);
+        Game game;
+
+        while (!pos.is_gameover()) {
+            const auto [move, score] = player->play(pos);
+            game.push_back({pos, move, static_cast<std::int16_t>(score), libataxx::Result::None});
+            pos.makemove(move);
+        }
+        game.push_back({pos, libataxx::Move::nomove(), 0, libataxx::Result::None});
+
+        const auto result = pos.get_result();
+        for (auto &entry : game) {
+            entry.result = result;
+        }
+
+        queue.push(std::move(game));
+    }
+
+    running--;
+}
+
+int main(int argc, char **argv) {
+    Options options;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "-threads") {
+            options.threads = std::max(1, std::stoi(value));
+        } else if (key == "-games") {
+            options.games = std::stoi(value);
+        } else if (key == "-out") {
+            options.out = value;
+        } else if (key == "-player") {
+            options.player = value;
+        } else if (key == "-depth") {
+            options.depth = std::stoi(value);
+        } else if (key == "-nodes") {
+            options.nodes = std::stoull(value);
+        } else if (key == "-plies") {
+            options.plies = std::stoi(value);
+        } else if (key == "-openings") {
+            options.openings = value;
+        } else if (key == "-seed") {
+            options.seed = std::stoull(value);
+        } else {
+            std::cerr << "Unknown option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream fs(options.out, std::ios::binary);
+    if (!fs.is_open()) {
+        std::cerr << "Could not open " << options.out << std::endl;
+        return 1;
+    }
+
+    std::cout << "Player: " << options.player << std::endl;
+    std::cout << "Threads: " << options.threads << std::endl;
+    std::cout << "Games: " << options.games << std::endl;
+    std::cout << "Output: " << options.out << std::endl;
+    std::cout << std::endl;
+
+    Queue<Game> queue{static_cast<std::size_t>(4 * options.threads)};
+    std::atomic<int> games_started = 0;
+    std::atomic<int> running = options.threads;
+    std::vector<std::thread> threads;
+
+    const auto t0 = steady_clock::now();
+    for (int i = 0; i < options.threads; ++i) {
+        threads.emplace_back(worker, std::cref(options), i, std::ref(games_started), std::ref(queue), std::ref(running));
+    }
+
+    // The only writer
+    libataxx::binpack::Writer writer{fs};
+    std::unordered_set<std::uint64_t> unique;
+    std::uint64_t games = 0;
+    std::uint64_t positions = 0;
+    auto last_report = t0;
+
+    const auto report = [&]() {
+        const auto dt = duration_cast<milliseconds>(steady_clock::now() - t0).count();
+        std::cout << "games " << games;
+        std::cout << " positions " << positions;
+        std::cout << " unique " << unique.size();
+        if (dt > 0) {
+            std::cout << " games/s " << 1000 * games / dt;
+            std::cout << " positions/s " << 1000 * positions / dt;
+        }
+        std::cout << std::endl;
+    };
+
+    for (;;) {
+        auto game = queue.try_pop();
+        if (!game) {
+            if (running == 0) {
+                game = queue.try_pop();
+                if (!game) {
+                    break;
+                }
+            } else {
+                std::this_thread::sleep_for(milliseconds(1));
+                continue;
+            }
+        }
+
+        for (const auto &entry : *game) {
+            writer.add(entry);
+            unique.insert(entry.pos.get_hash());
+        }
+        games++;
+        positions += game->size();
+
+        if (steady_clock::now() - last_report >= seconds(5)) {
+            last_report = steady_clock::now();
+            report();
+        }
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    writer.flush();
+
+    std::cout << std::endl;
+    report();
+    std::cout << "Chains: " << writer.num_chains() << std::endl;
+    std::cout << "Duplicates: " << positions - unique.size() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <libataxx/binpack.hpp>
+#include <libataxx/pgn.hpp>
+#include <libataxx/position_set.hpp>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+// Writes every position not seen before, symmetric positions count as seen
+class Output {
+   public:
+    Output(std::ostream &os, libataxx::PositionSet &set) : writer_{os}, set_{set} {
+    }
+
+    void add(const libataxx::binpack::TrainingEntry &entry) {
+        total_++;
+        if (set_.insert(entry.pos)) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            writer_.add(entry);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t total() const noexcept {
+        return total_;
+    }
+
+   private:
+    std::mutex mtx_;
+    libataxx::binpack::Writer writer_;
+    libataxx::PositionSet &set_;
+    std::atomic<std::uint64_t> total_ = 0;
+};
+
+void read_pgn(const std::string &path, Output &output) {
+    std::ifstream fs(path);
+    while (const auto pgn = libataxx::pgn::read(fs)) {
+        const auto result = libataxx::pgn::get_result(*pgn);
+        auto pos = libataxx::pgn::start_position(*pgn);
+
+        // A corrupt game is kept up to its first illegal move
+        for (const auto &move : pgn->root().mainline()) {
+            if (pos.is_gameover() || move == libataxx::Move::nomove() || !pos.is_legal_move(move)) {
+                break;
+            }
+            output.add({pos, move, 0, result});
+            pos.makemove(move);
+        }
+        output.add({pos, libataxx::Move::nomove(), 0, result});
+    }
+}
+
+void read_binpack(const std::string &path, Output &output) {
+    std::ifstream fs(path, std::ios::binary);
+    libataxx::binpack::Reader reader{fs};
+    libataxx::binpack::TrainingEntry entry;
+    while (reader.next(entry)) {
+        output.add(entry);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cout << "Usage: dedup [-bloom] [-memory keys] [-spill dir] output.binpack input.pgn|input.binpack..."
+                  << std::endl;
+        return 1;
+    }
+
+    libataxx::PositionSetOptions options;
+    int idx = 1;
+    for (; idx < argc && argv[idx][0] == '-'; ++idx) {
+        const std::string key = argv[idx];
+        if (key == "-bloom") {
+            options.bloom = true;
+        } else if (key == "-memory" && idx + 1 < argc) {
+            options.max_memory_keys = std::stoull(argv[++idx]);
+        } else if (key == "-spill" && idx + 1 < argc) {
+            options.spill_directory = argv[++idx];
+        } else {
+            std::cerr << "Unknown option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    if (idx >= argc) {
+        std::cerr << "Missing output file" << std::endl;
+        return 1;
+    }
+
+    std::ofstream fs(argv[idx], std::ios::binary);
+    if (!fs.is_open()) {
+        std::cerr << "Could not open " << argv[idx] << std::endl;
+        return 1;
+    }
+
+    libataxx::PositionSet set{options};
+    Output output{fs, set};
+    std::vector<std::thread> threads;
+
+    // One thread per input file
+    const auto t0 = steady_clock::now();
+    for (int i = idx + 1; i < argc; ++i) {
+        const std::string path = argv[i];
+        const bool is_pgn = path.size() >= 4 && path.substr(path.size() - 4) == ".pgn";
+        threads.emplace_back([path, is_pgn, &output]() {
+            try {
+                if (is_pgn) {
+                    read_pgn(path, output);
+                } else {
+                    read_binpack(path, output);
+                }
+            } catch (const std::exception &e) {
+                std::cerr << path << ": " << e.what() << std::endl;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const auto t1 = steady_clock::now();
+
+    std::cout << "Positions: " << output.total() << std::endl;
+    std::cout << "Unique: " << set.size() << std::endl;
+    std::cout << "Spilled: " << set.spilled() << std::endl;
+    std::cout << "Time: " << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <libataxx/position.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include "perft_cache.hpp"
+
+using namespace std::chrono;
+
+// Shallower subtrees are quicker to count than to look up
+constexpr int min_cached_depth = 3;
+
+struct Counters {
+    std::uint64_t hits = 0;
+    std::uint64_t stores = 0;
+};
+
+[[nodiscard]] std::uint64_t cached_perft(PerftCache &cache,
+                                         const libataxx::Position &pos,
+                                         const int depth,
+                                         const std::uint8_t symmetries,
+                                         Counters &counters) {
+    if (depth < min_cached_depth) {
+        return pos.perft(depth);
+    }
+
+    const auto key = PerftCache::key(pos, depth, symmetries);
+    std::uint64_t nodes = 0;
+    if (cache.probe(key, depth, nodes)) {
+        counters.hits++;
+        return nodes;
+    }
+
+    libataxx::Move moves[libataxx::max_moves];
+    const int num_moves = pos.legal_moves(moves);
+    for (int i = 0; i < num_moves; ++i) {
+        nodes += cached_perft(cache, pos.after_move(moves[i]), depth - 1, symmetries, counters);
+    }
+
+    cache.store(key, depth, nodes);
+    counters.stores++;
+    return nodes;
+}
+
+int main(int argc, char **argv) {
+    std::string path = "perft.cache";
+    std::size_t mb = 1024;
+    int threads = std::max(1U, std::thread::hardware_concurrency());
+    int depth = 8;
+    std::string fen;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-cache" && i + 1 < argc) {
+            path = argv[++i];
+        } else if (key == "-mb" && i + 1 < argc) {
+            mb = std::max(1ULL, std::stoull(argv[++i]));
+        } else if (key == "-threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-depth" && i + 1 < argc) {
+            depth = std::stoi(argv[++i]);
+        } else if (key[0] == '-') {
+            std::cout << "Usage: diskperft [-cache file] [-mb n] [-threads n] [-depth n] [fen]" << std::endl;
+            return 1;
+        } else {
+            fen += (fen.empty() ? "" : " ") + key;
+        }
+    }
+    if (fen.empty()) {
+        fen = "startpos";
+    }
+
+    const auto root = libataxx::Position::from_fen(fen);
+    if (!root) {
+        std::cerr << "Invalid FEN " << fen << std::endl;
+        return 1;
+    }
+
+    try {
+        PerftCache cache{path, mb};
+
+        std::cout << "FEN: " << fen << std::endl;
+        std::cout << "Depth: " << depth << std::endl;
+        std::cout << "Cache: " << path << " " << cache.size_mb() << "MB " << cache.size() << " entries" << std::endl;
+        std::cout << std::endl;
+
+        // Workers share out the positions two plies down
+        const auto root_moves = root->legal_moves();
+        const auto symmetries = root->get_symmetries();
+        std::vector<std::pair<std::size_t, libataxx::Position>> tasks;
+        std::vector<std::atomic<std::uint64_t>> divide(root_moves.size());
+        for (std::size_t i = 0; i < root_moves.size() && depth >= 2; ++i) {
+            const auto child = root->after_move(root_moves[i]);
+            for (const auto &move : child.legal_moves()) {
+                tasks.emplace_back(i, child.after_move(move));
+            }
+        }
+
+        std::atomic<std::size_t> next = 0;
+        std::atomic<std::uint64_t> hits = 0;
+        std::atomic<std::uint64_t> stores = 0;
+        std::vector<std::thread> workers;
+
+        const auto t0 = steady_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&]() {
+                Counters counters;
+                for (auto i = next++; i < tasks.size(); i = next++) {
+                    const auto &[root_move, pos] = tasks[i];
+                    divide[root_move] += cached_perft(cache, pos, depth - 2, symmetries, counters);
+                }
+                hits += counters.hits;
+                stores += counters.stores;
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        const auto t1 = steady_clock::now();
+
+        std::uint64_t nodes = depth < 2 ? root->perft(depth) : 0;
+        for (std::size_t i = 0; i < root_moves.size() && depth >= 2; ++i) {
+            std::cout << root_moves[i] << " " << divide[i] << std::endl;
+            nodes += divide[i];
+        }
+
+        const auto ms = duration_cast<milliseconds>(t1 - t0).count();
+        std::cout << std::endl;
+        std::cout << "Nodes: " << nodes << std::endl;
+        std::cout << "Time: " << ms << "ms" << std::endl;
+        std::cout << "Cache hits: " << hits << std::endl;
+        std::cout << "Cache stores: " << stores << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
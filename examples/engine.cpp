@@ -0,0 +1,17 @@
+#include <libataxx/uai.hpp>
+#include <memory>
+#include <string>
+
+// A UAI engine built from the library's own search, "engine mcts" for MCTS
+int main(int argc, char **argv) {
+    std::unique_ptr<libataxx::uai::Engine> engine;
+    if (argc > 1 && std::string(argv[1]) == "mcts") {
+        engine = std::make_unique<libataxx::uai::MCTSEngine>();
+    } else {
+        engine = std::make_unique<libataxx::uai::SearchEngine>();
+    }
+
+    libataxx::uai::Driver driver{*engine};
+    driver.run();
+    return 0;
+}
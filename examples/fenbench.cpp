@@ -0,0 +1,103 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <libataxx/fen.hpp>
+#include <libataxx/position.hpp>
+#include <random>
+#include <string>
+#include <vector>
+#include "fens.hpp"
+
+using namespace std::chrono;
+
+// Random positions reached from the benchmark layouts
+[[nodiscard]] std::vector<libataxx::Position> make_positions(const std::size_t count) {
+    std::mt19937_64 rng(0);
+    std::vector<libataxx::Position> positions;
+    positions.reserve(count);
+
+    while (positions.size() < count) {
+        auto pos = libataxx::Position{benchmark_fens.at(rng() % benchmark_fens.size())};
+        libataxx::Move moves[libataxx::max_moves];
+        while (!pos.is_gameover() && positions.size() < count) {
+            positions.push_back(pos);
+            const int num_moves = pos.legal_moves(moves);
+            pos.makemove(moves[rng() % num_moves]);
+        }
+    }
+
+    return positions;
+}
+
+template <typename F>
+void bench(const std::string &name, const std::size_t count, F f) {
+    const auto t0 = steady_clock::now();
+    const auto checksum = f();
+    const auto t1 = steady_clock::now();
+    const auto ns = duration_cast<nanoseconds>(t1 - t0).count();
+
+    std::cout << std::left << std::setw(16) << name;
+    std::cout << std::right << std::setw(10) << ns / 1000000 << "ms";
+    std::cout << std::setw(10) << static_cast<double>(ns) / count << "ns/fen";
+    std::cout << "  checksum " << checksum << std::endl;
+}
+
+int main(int argc, char **argv) {
+    std::size_t count = 1000000;
+    if (argc > 1) {
+        count = std::stoull(argv[1]);
+    }
+
+    const auto positions = make_positions(count);
+    std::string buffer;
+    libataxx::fen::write_lines(positions, buffer);
+
+    std::cout << "Positions: " << positions.size() << std::endl;
+    std::cout << std::endl;
+
+    bench("get_fen", count, [&]() {
+        std::size_t total = 0;
+        for (const auto &pos : positions) {
+            total += pos.get_fen().size();
+        }
+        return total;
+    });
+
+    bench("write_fen", count, [&]() {
+        std::size_t total = 0;
+        char fen[libataxx::Position::fen_buffer_size];
+        for (const auto &pos : positions) {
+            total += pos.write_fen(fen) - fen;
+        }
+        return total;
+    });
+
+    // Reuse the output string the way a logger would, so the timing isn't
+    // dominated by page faults on fresh memory
+    std::string out = buffer;
+    bench("write_lines", count, [&]() {
+        out.clear();
+        libataxx::fen::write_lines(positions, out);
+        return out.size();
+    });
+
+    bench("set_fen", count, [&]() {
+        std::size_t total = 0;
+        libataxx::Position pos;
+        std::size_t start = 0;
+        while (start < buffer.size()) {
+            const auto end = buffer.find('\n', start);
+            pos.set_fen(std::string_view(buffer).substr(start, end - start));
+            total += pos.get_hash() & 0xff;
+            start = end + 1;
+        }
+        return total;
+    });
+
+    bench("parse_lines", count, [&]() {
+        const auto parsed = libataxx::fen::parse_lines(buffer);
+        return parsed.size();
+    });
+
+    return 0;
+}
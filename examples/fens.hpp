@@ -0,0 +1,31 @@
+#ifndef FENS_HPP
+#define FENS_HPP
+
+#include <array>
+#include <string>
+
+// Common gap layouts
+const std::array<std::string, 20> benchmark_fens = {
+    "x5o/7/7/7/7/7/o5x x 0 1",
+    "x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1",
+    "x5o/7/3-3/2-1-2/3-3/7/o5x x 0 1",
+    "x2-2o/3-3/2---2/7/2---2/3-3/o2-2x x 0 1",
+    "x2-2o/3-3/7/--3--/7/3-3/o2-2x x 0 1",
+    "x1-1-1o/2-1-2/2-1-2/7/2-1-2/2-1-2/o1-1-1x x 0 1",
+    "x5o/7/2-1-2/3-3/2-1-2/7/o5x x 0 1",
+    "x5o/7/3-3/2---2/3-3/7/o5x x 0 1",
+    "x5o/2-1-2/1-3-1/7/1-3-1/2-1-2/o5x x 0 1",
+    "x5o/1-3-1/2-1-2/7/2-1-2/1-3-1/o5x x 0 1",
+    "x-1-1-o/-1-1-1-/1-1-1-1/-1-1-1-/1-1-1-1/-1-1-1-/o-1-1-x x 0 1",
+    "x-1-1-o/1-1-1-1/1-1-1-1/1-1-1-1/1-1-1-1/1-1-1-1/o-1-1-x x 0 1",
+    "x1-1-1o/2-1-2/-------/2-1-2/-------/2-1-2/o1-1-1x x 0 1",
+    "x5o/1-----1/1-3-1/1-1-1-1/1-3-1/1-----1/o5x x 0 1",
+    "x-1-1-o/1-1-1-1/-1-1-1-/-1-1-1-/-1-1-1-/1-1-1-1/o-1-1-x/ x 0 1",
+    "x5o/1--1--1/1--1--1/7/1--1--1/1--1--1/o5x x 0 1",
+    "x-3-o/1-1-1-1/1-1-1-1/3-3/1-1-1-1/1-1-1-1/o-3-x x 0 1",
+    "x2-2o/3-3/3-3/-------/3-3/3-3/o2-2x x 0 1",
+    "x2-2o/2-1-2/1-3-1/-2-2-/1-3-1/2-1-2/o2-2x x 0 1",
+    "x5o/6-/1-4-/-3--1/2-4/7/o-3-x x 0 1",
+};
+
+#endif
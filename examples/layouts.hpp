@@ -0,0 +1,96 @@
+#ifndef LAYOUTS_HPP
+#define LAYOUTS_HPP
+
+#include <cstdint>
+#include <libataxx/bitboard.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include <set>
+#include <vector>
+
+// Gap layouts for openings, each one fair to both sides
+
+constexpr libataxx::Bitboard corners = libataxx::Bitboard{0x41000000000041ULL};
+
+// The same layout in any orientation maps to one bitboard
+[[nodiscard]] inline libataxx::Bitboard canonical_layout(const libataxx::Bitboard &gaps) noexcept {
+    auto best = gaps;
+    for (const auto t : libataxx::transforms) {
+        const auto bb = libataxx::transform(gaps, t);
+        if (bb.data() < best.data()) {
+            best = bb;
+        }
+    }
+    return best;
+}
+
+// Squares grouped by the transforms that map them onto each other
+[[nodiscard]] inline std::vector<libataxx::Bitboard> orbits(const std::vector<libataxx::Transform> &group) {
+    std::vector<libataxx::Bitboard> result;
+    libataxx::Bitboard seen;
+    for (const auto &sq : libataxx::Bitboard(libataxx::Bitmask::All)) {
+        if (seen & libataxx::Bitboard{sq}) {
+            continue;
+        }
+        libataxx::Bitboard orbit;
+        for (const auto t : group) {
+            orbit |= libataxx::Bitboard{libataxx::transform(sq, t)};
+        }
+        seen |= orbit;
+        if (!(orbit & corners)) {
+            result.push_back(orbit);
+        }
+    }
+    return result;
+}
+
+// Every layout with all 8 symmetries, built from whole orbits
+[[nodiscard]] inline std::vector<libataxx::Bitboard> symmetric_layouts(const int max_gaps) {
+    const auto all = orbits({libataxx::transforms.begin(), libataxx::transforms.end()});
+    std::vector<libataxx::Bitboard> layouts;
+    for (std::uint32_t mask = 0; mask < (1U << all.size()); ++mask) {
+        libataxx::Bitboard gaps;
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            if (mask & (1U << i)) {
+                gaps |= all[i];
+            }
+        }
+        if (gaps.count() <= max_gaps) {
+            layouts.push_back(gaps);
+        }
+    }
+    return layouts;
+}
+
+// Layouts that are the same for both sides, found by picking random pairs of
+// squares that FlipV swaps. FlipV maps each side's corners onto the other's,
+// other transforms like Rot180 can keep gaps next to one side only
+[[nodiscard]] inline std::vector<libataxx::Bitboard> random_layouts(const int count,
+                                                                    const int max_gaps,
+                                                                    std::mt19937_64 &rng) {
+    const auto pairs = orbits({libataxx::Transform::None, libataxx::Transform::FlipV});
+    std::set<std::uint64_t> seen;
+    std::vector<libataxx::Bitboard> layouts;
+
+    for (int attempt = 0; attempt < 100 * count && static_cast<int>(layouts.size()) < count; ++attempt) {
+        libataxx::Bitboard gaps;
+        const int target = rng() % (max_gaps + 1);
+        while (gaps.count() < target) {
+            const auto pair = pairs[rng() % pairs.size()];
+            if ((gaps | pair).count() > max_gaps) {
+                break;
+            }
+            gaps |= pair;
+        }
+
+        // One of each layout, kept in the orientation it was built in since
+        // the canonical one might only be symmetric under FlipH
+        if (seen.insert(canonical_layout(gaps).data()).second) {
+            layouts.push_back(gaps);
+        }
+    }
+
+    return layouts;
+}
+
+#endif
@@ -0,0 +1,551 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <libataxx/pgn.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/sprt.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "process.hpp"
+
+using namespace std::chrono;
+
+// Extra time an engine gets past its clock before it loses on time
+constexpr milliseconds time_margin{100};
+
+// How long engines without a clock get to reply
+constexpr milliseconds reply_timeout{60000};
+
+// How long an engine that ran out of time gets to answer stop before it's
+// restarted, so its late bestmove can't be read as a reply in the next game
+constexpr milliseconds stop_timeout{1000};
+
+struct TimeControl {
+    milliseconds time{0};
+    milliseconds inc{0};
+    milliseconds movetime{0};
+    int depth = 0;
+    std::uint64_t nodes = 0;
+};
+
+struct EngineConfig {
+    std::string name;
+    std::string command;
+    TimeControl tc;
+    std::map<std::string, std::string> options;
+};
+
+struct Options {
+    std::vector<EngineConfig> engines;
+    int concurrency = std::max(1U, std::thread::hardware_concurrency());
+    int rounds = 10;
+    std::string openings;
+    std::string pgnout;
+    std::uint64_t seed = 0;
+    // Stop as soon as the test concludes, -rounds is still the limit
+    bool sprt = false;
+    double elo0 = 0.0;
+    double elo1 = 5.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+// Game results from the first engine's point of view
+struct Score {
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+    libataxx::sprt::SPRT sprt;
+};
+
+void print_stats(const Options &options, const Score &score) {
+    const auto &penta = score.sprt.pentanomial();
+    const auto [elo, error] = libataxx::sprt::elo(penta);
+    std::cout << "Elo: " << std::fixed << std::setprecision(1) << elo << " +/- " << error;
+    std::cout << " LOS: " << 100.0 * libataxx::sprt::los(penta) << "%";
+    std::cout << " Penta: [" << penta.counts[0] << ", " << penta.counts[1] << ", " << penta.counts[2] << ", "
+              << penta.counts[3] << ", " << penta.counts[4] << "]";
+    if (options.sprt) {
+        std::cout << std::setprecision(2) << " LLR: " << score.sprt.llr() << " (" << score.sprt.lower_bound() << ", "
+                  << score.sprt.upper_bound() << ")";
+    }
+    std::cout << std::defaultfloat << std::endl;
+}
+
+class Engine {
+   public:
+    explicit Engine(const EngineConfig &config) : config_{config} {
+        start();
+    }
+
+    ~Engine() {
+        process_->write_line("quit");
+    }
+
+    void new_game() {
+        process_->write_line("uainewgame");
+        ready();
+    }
+
+    // The engine's move, nomove if it couldn't be parsed, or nothing if it ran
+    // out of time or stopped responding
+    [[nodiscard]] std::optional<libataxx::Move> go(const std::string &position,
+                                                   const std::string &go,
+                                                   const milliseconds limit) {
+        process_->write_line(position);
+        process_->write_line(go);
+
+        if (const auto line = read_bestmove(steady_clock::now() + limit)) {
+            std::stringstream ss{*line};
+            std::string word;
+            ss >> word >> word;
+            try {
+                return libataxx::Move::from_uai(word);
+            } catch (const std::exception &) {
+                return libataxx::Move::nomove();
+            }
+        }
+
+        // The search is still running, its bestmove has to be out of the way
+        // before the engine is asked anything else
+        process_->write_line("stop");
+        if (!read_bestmove(steady_clock::now() + stop_timeout)) {
+            start();
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const EngineConfig &config() const noexcept {
+        return config_;
+    }
+
+   private:
+    // Starts the engine, or starts it again in place of one that stopped
+    // responding
+    void start() {
+        process_ = std::make_unique<Process>(config_.command);
+        const auto deadline = steady_clock::now() + reply_timeout;
+        process_->write_line("uai");
+        wait_for("uaiok", deadline);
+        for (const auto &[name, value] : config_.options) {
+            process_->write_line("setoption name " + name + " value " + value);
+        }
+        ready();
+    }
+
+    void ready() {
+        process_->write_line("isready");
+        wait_for("readyok", steady_clock::now() + reply_timeout);
+    }
+
+    [[nodiscard]] std::optional<std::string> read_bestmove(const steady_clock::time_point deadline) {
+        while (auto line = process_->read_line(deadline)) {
+            if (line->rfind("bestmove ", 0) == 0) {
+                return line;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void wait_for(const std::string &token, const steady_clock::time_point deadline) {
+        while (const auto line = process_->read_line(deadline)) {
+            if (*line == token) {
+                return;
+            }
+        }
+        throw std::runtime_error(config_.name + " did not reply with " + token);
+    }
+
+    EngineConfig config_;
+    std::unique_ptr<Process> process_;
+};
+
+class PGNWriter {
+   public:
+    explicit PGNWriter(const std::string &path) {
+        if (!path.empty()) {
+            fs_.open(path, std::ios::app);
+        }
+    }
+
+    void write(const libataxx::pgn::PGN &pgn) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (fs_.is_open()) {
+            fs_ << pgn;
+            fs_.flush();
+        }
+    }
+
+   private:
+    std::mutex mtx_;
+    std::ofstream fs_;
+};
+
+[[nodiscard]] std::string result_string(const libataxx::Result result) {
+    switch (result) {
+        case libataxx::Result::WhiteWin:
+            return "1-0";
+        case libataxx::Result::BlackWin:
+            return "0-1";
+        case libataxx::Result::Draw:
+            return "1/2-1/2";
+        default:
+            return "*";
+    }
+}
+
+[[nodiscard]] std::string go_string(const TimeControl &own,
+                                    const TimeControl &other,
+                                    const milliseconds own_clock,
+                                    const milliseconds other_clock,
+                                    const libataxx::Side side) {
+    if (own.movetime.count() > 0) {
+        return "go movetime " + std::to_string(own.movetime.count());
+    }
+    if (own.depth > 0) {
+        return "go depth " + std::to_string(own.depth);
+    }
+    if (own.nodes > 0) {
+        return "go nodes " + std::to_string(own.nodes);
+    }
+
+    const bool black = side == libataxx::Side::Black;
+    const auto btime = black ? own_clock : other_clock;
+    const auto wtime = black ? other_clock : own_clock;
+    const auto binc = black ? own.inc : other.inc;
+    const auto winc = black ? other.inc : own.inc;
+    return "go btime " + std::to_string(btime.count()) + " wtime " + std::to_string(wtime.count()) + " binc " +
+           std::to_string(binc.count()) + " winc " + std::to_string(winc.count());
+}
+
+// Plays one game, engines[0] has black
+[[nodiscard]] libataxx::Result play_game(Engine *engines[2], const std::string &opening, PGNWriter &writer) {
+    auto pos = libataxx::Position{opening};
+    const auto fen = pos.get_fen();
+
+    libataxx::pgn::PGN pgn;
+    pgn.header().add("Event", "Match");
+    pgn.header().add("FEN", fen);
+    pgn.header().add("Black", engines[0]->config().name);
+    pgn.header().add("White", engines[1]->config().name);
+    pgn.set_black_first(pos.get_turn() == libataxx::Side::Black);
+    auto *node = pgn.root();
+
+    engines[0]->new_game();
+    engines[1]->new_game();
+
+    milliseconds clocks[2] = {engines[0]->config().tc.time, engines[1]->config().tc.time};
+    std::string position = "position fen " + fen + " moves";
+    auto result = libataxx::Result::None;
+    std::string termination;
+
+    // Adjudication follows the rules in Position
+    while (!pos.is_gameover()) {
+        const int us = pos.get_turn() == libataxx::Side::Black ? 0 : 1;
+        const auto &tc = engines[us]->config().tc;
+        const auto &other_tc = engines[!us]->config().tc;
+        const auto go = go_string(tc, other_tc, clocks[us], clocks[!us], pos.get_turn());
+
+        auto limit = reply_timeout;
+        if (tc.movetime.count() > 0) {
+            limit = tc.movetime + time_margin;
+        } else if (tc.time.count() > 0) {
+            limit = clocks[us] + time_margin;
+        }
+
+        const auto t0 = steady_clock::now();
+        const auto move = engines[us]->go(position, go, limit);
+        const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - t0);
+
+        const auto loss = us == 0 ? libataxx::Result::WhiteWin : libataxx::Result::BlackWin;
+        if (!move) {
+            result = loss;
+            termination = "time forfeit";
+            break;
+        }
+        // Moves that couldn't be parsed come back as nomove, which the
+        // position can't be asked about
+        if (*move == libataxx::Move::nomove() || !pos.is_legal_move(*move)) {
+            result = loss;
+            termination = "illegal move " + static_cast<std::string>(*move);
+            break;
+        }
+
+        if (tc.time.count() > 0) {
+            clocks[us] -= elapsed;
+            if (clocks[us].count() < 0) {
+                result = loss;
+                termination = "time forfeit";
+                break;
+            }
+            clocks[us] += tc.inc;
+        }
+
+        pos.makemove(*move);
+        position += " " + static_cast<std::string>(*move);
+        node = node->add_mainline(*move);
+    }
+
+    if (result == libataxx::Result::None) {
+        result = pos.get_result();
+    }
+
+    pgn.header().add("Result", result_string(result));
+    if (!termination.empty()) {
+        pgn.header().add("Termination", termination);
+    }
+    writer.write(pgn);
+
+    return result;
+}
+
+[[nodiscard]] std::vector<std::string> load_openings(const Options &options) {
+    std::vector<std::string> openings;
+
+    if (!options.openings.empty()) {
+        std::ifstream fs(options.openings);
+        if (!fs.is_open()) {
+            throw std::runtime_error("Could not open " + options.openings);
+        }
+
+        // EPD opcodes after the FEN are ignored
+        std::string line;
+        while (std::getline(fs, line)) {
+            line = line.substr(0, line.find(';'));
+            if (libataxx::Position::from_fen(line)) {
+                openings.push_back(line);
+            }
+        }
+    }
+
+    if (openings.empty()) {
+        openings.push_back("startpos");
+    }
+
+    std::mt19937_64 rng(options.seed);
+    std::shuffle(openings.begin(), openings.end(), rng);
+    return openings;
+}
+
+// Each worker keeps its own pair of engines alive between games
+void worker(const Options &options,
+            const std::vector<std::string> &openings,
+            std::atomic<int> &next_round,
+            PGNWriter &writer,
+            std::mutex &mtx,
+            Score &score,
+            std::atomic<bool> &stop) {
+    Engine a{options.engines[0]};
+    Engine b{options.engines[1]};
+
+    for (int round = next_round++; round < options.rounds && !stop; round = next_round++) {
+        const auto &opening = openings[round % openings.size()];
+
+        // Both engines play both colours from the same opening
+        Engine *first[2] = {&a, &b};
+        Engine *second[2] = {&b, &a};
+        const auto r1 = play_game(first, opening, writer);
+        const auto r2 = play_game(second, opening, writer);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        score.wins += (r1 == libataxx::Result::BlackWin) + (r2 == libataxx::Result::WhiteWin);
+        score.losses += (r1 == libataxx::Result::WhiteWin) + (r2 == libataxx::Result::BlackWin);
+        score.draws += (r1 == libataxx::Result::Draw) + (r2 == libataxx::Result::Draw);
+
+        // Pairs still being played when the test concludes are counted too
+        const int half_points = 2 * (r1 == libataxx::Result::BlackWin) + (r1 == libataxx::Result::Draw) +
+                                2 * (r2 == libataxx::Result::WhiteWin) + (r2 == libataxx::Result::Draw);
+        if (score.sprt.add(half_points) != libataxx::sprt::Status::Continue && options.sprt) {
+            stop = true;
+        }
+
+        std::cout << "Round " << round + 1 << " " << a.config().name << " vs " << b.config().name << ": ";
+        std::cout << score.wins << " - " << score.losses << " - " << score.draws << std::endl;
+        print_stats(options, score);
+    }
+}
+
+[[nodiscard]] TimeControl parse_tc(const std::string &key, const std::string &value, TimeControl tc) {
+    if (key == "tc") {
+        // seconds+increment
+        const auto plus = value.find('+');
+        tc.time = milliseconds(static_cast<long long>(1000 * std::stod(value.substr(0, plus))));
+        if (plus != std::string::npos) {
+            tc.inc = milliseconds(static_cast<long long>(1000 * std::stod(value.substr(plus + 1))));
+        }
+    } else if (key == "st") {
+        tc.movetime = milliseconds(static_cast<long long>(1000 * std::stod(value)));
+    } else if (key == "depth") {
+        tc.depth = std::stoi(value);
+    } else if (key == "nodes") {
+        tc.nodes = std::stoull(value);
+    }
+    return tc;
+}
+
+void apply(EngineConfig &config, const std::string &key, const std::string &value) {
+    if (key == "cmd") {
+        config.command = value;
+    } else if (key == "name") {
+        config.name = value;
+    } else if (key.rfind("option.", 0) == 0) {
+        config.options[key.substr(7)] = value;
+    } else if (key == "tc" || key == "st" || key == "depth" || key == "nodes") {
+        config.tc = parse_tc(key, value, config.tc);
+    } else {
+        throw std::invalid_argument("Unknown engine option " + key);
+    }
+}
+
+int main(int argc, char **argv) {
+    // Writing to an engine that has exited shouldn't kill the match
+    std::signal(SIGPIPE, SIG_IGN);
+
+    Options options;
+    EngineConfig each;
+    std::vector<std::vector<std::pair<std::string, std::string>>> engine_args;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string key = argv[i];
+            if (key == "-engine" || key == "-each") {
+                std::vector<std::pair<std::string, std::string>> args;
+                while (i + 1 < argc && argv[i + 1][0] != '-') {
+                    const std::string arg = argv[++i];
+                    const auto eq = arg.find('=');
+                    if (eq == std::string::npos) {
+                        throw std::invalid_argument("Expected key=value, got " + arg);
+                    }
+                    args.emplace_back(arg.substr(0, eq), arg.substr(eq + 1));
+                }
+                if (key == "-each") {
+                    for (const auto &[k, v] : args) {
+                        apply(each, k, v);
+                    }
+                } else {
+                    engine_args.push_back(args);
+                }
+            } else if (key == "-concurrency" && i + 1 < argc) {
+                options.concurrency = std::max(1, std::stoi(argv[++i]));
+            } else if (key == "-rounds" && i + 1 < argc) {
+                options.rounds = std::stoi(argv[++i]);
+            } else if (key == "-openings" && i + 1 < argc) {
+                options.openings = argv[++i];
+            } else if (key == "-pgnout" && i + 1 < argc) {
+                options.pgnout = argv[++i];
+            } else if (key == "-seed" && i + 1 < argc) {
+                options.seed = std::stoull(argv[++i]);
+            } else if (key == "-sprt") {
+                options.sprt = true;
+                while (i + 1 < argc && argv[i + 1][0] != '-') {
+                    const std::string arg = argv[++i];
+                    const auto eq = arg.find('=');
+                    const auto name = arg.substr(0, eq);
+                    const auto value = eq == std::string::npos ? 0.0 : std::stod(arg.substr(eq + 1));
+                    if (name == "elo0") {
+                        options.elo0 = value;
+                    } else if (name == "elo1") {
+                        options.elo1 = value;
+                    } else if (name == "alpha") {
+                        options.alpha = value;
+                    } else if (name == "beta") {
+                        options.beta = value;
+                    } else {
+                        throw std::invalid_argument("Unknown SPRT option " + arg);
+                    }
+                }
+            } else {
+                throw std::invalid_argument("Unknown option " + key);
+            }
+        }
+
+        // Settings for each engine override the shared ones
+        for (const auto &args : engine_args) {
+            auto config = each;
+            for (const auto &[k, v] : args) {
+                apply(config, k, v);
+            }
+            if (config.name.empty()) {
+                config.name = config.command;
+            }
+            options.engines.push_back(config);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (options.engines.size() != 2) {
+        std::cout << "Usage: match -engine cmd=... [name=...] [tc=10+0.1|st=0.1|depth=n|nodes=n] [option.Name=value]"
+                  << std::endl;
+        std::cout << "             -engine cmd=... [...] [-each ...] [-concurrency n] [-rounds n]" << std::endl;
+        std::cout << "             [-openings file.epd] [-pgnout file.pgn] [-seed n]" << std::endl;
+        std::cout << "             [-sprt elo0=0 elo1=5 alpha=0.05 beta=0.05]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> openings;
+    try {
+        openings = load_openings(options);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    PGNWriter writer{options.pgnout};
+    std::atomic<int> next_round = 0;
+    std::mutex mtx;
+    Score score;
+    score.sprt = libataxx::sprt::SPRT{options.elo0, options.elo1, options.alpha, options.beta};
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> threads;
+
+    const auto t0 = steady_clock::now();
+    for (int i = 0; i < options.concurrency; ++i) {
+        threads.emplace_back([&]() {
+            try {
+                worker(options, openings, next_round, writer, mtx, score, stop);
+            } catch (const std::exception &e) {
+                std::lock_guard<std::mutex> lock(mtx);
+                std::cerr << e.what() << std::endl;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const auto t1 = steady_clock::now();
+
+    const int games = score.wins + score.losses + score.draws;
+    std::cout << std::endl;
+    std::cout << options.engines[0].name << " vs " << options.engines[1].name << std::endl;
+    std::cout << "Games: " << games << std::endl;
+    std::cout << "Score: " << score.wins << " - " << score.losses << " - " << score.draws << std::endl;
+    print_stats(options, score);
+    if (options.sprt) {
+        switch (score.sprt.status()) {
+            case libataxx::sprt::Status::AcceptH0:
+                std::cout << "SPRT: H0 accepted" << std::endl;
+                break;
+            case libataxx::sprt::Status::AcceptH1:
+                std::cout << "SPRT: H1 accepted" << std::endl;
+                break;
+            default:
+                std::cout << "SPRT: inconclusive" << std::endl;
+                break;
+        }
+    }
+    std::cout << "Time: " << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+    return 0;
+}
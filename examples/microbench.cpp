@@ -0,0 +1,428 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <libataxx/board.hpp>
+#include <libataxx/pgn.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "fens.hpp"
+#include "perf_counters.hpp"
+
+using namespace std::chrono;
+
+// Stops the compiler from discarding a result it can see is unused
+template <typename T>
+inline void do_not_optimize(const T &value) noexcept {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Stops the compiler from caching memory across the barrier
+inline void clobber_memory() noexcept {
+    asm volatile("" : : : "memory");
+}
+
+struct Options {
+    std::size_t positions = 10000;
+    std::size_t games = 200;
+    // Passes over the inputs per repetition, fixed so runs can be compared
+    int iterations = 20;
+    int repetitions = 5;
+    std::string filter;
+    std::string json;
+    bool counters = false;
+};
+
+struct Benchmark {
+    std::string name;
+    // Operations done by one pass
+    std::size_t ops;
+    std::function<void()> pass;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t ops = 0;
+    double min = 0.0;
+    double median = 0.0;
+    double max = 0.0;
+    // Counted over one more set of passes, outside the timed repetitions
+    std::optional<CounterSample> counters;
+};
+
+// Positions from random games on the benchmark layouts, along with a legal
+// move for each one
+struct Inputs {
+    std::vector<libataxx::Position> positions;
+    std::vector<libataxx::Move> moves;
+    std::vector<std::string> fens;
+    std::vector<libataxx::pgn::PGN> games;
+    // One board per layout, and the layout of each position
+    std::vector<libataxx::Board> boards;
+    std::vector<std::size_t> layouts;
+};
+
+[[nodiscard]] Inputs make_inputs(const Options &options) {
+    std::mt19937_64 rng(0);
+    Inputs inputs;
+    libataxx::Move moves[libataxx::max_moves];
+
+    for (const auto &fen : benchmark_fens) {
+        inputs.boards.emplace_back(libataxx::Position{fen});
+    }
+
+    while (inputs.positions.size() < options.positions || inputs.games.size() < options.games) {
+        const auto layout = rng() % benchmark_fens.size();
+        auto pos = libataxx::Position{benchmark_fens.at(layout)};
+        libataxx::pgn::PGN pgn;
+        pgn.header().add("FEN", pos.get_fen());
+        auto *node = pgn.root();
+
+        while (!pos.is_gameover()) {
+            const int num_moves = pos.legal_moves(moves);
+            const auto move = moves[rng() % num_moves];
+            if (inputs.positions.size() < options.positions) {
+                inputs.positions.push_back(pos);
+                inputs.moves.push_back(move);
+                inputs.fens.push_back(pos.get_fen());
+                inputs.layouts.push_back(layout);
+            }
+            node = node->add_mainline(move);
+            pos.makemove(move);
+        }
+
+        if (inputs.games.size() < options.games) {
+            pgn.header().add("Result", "*");
+            inputs.games.push_back(pgn);
+        }
+    }
+
+    return inputs;
+}
+
+[[nodiscard]] std::vector<Benchmark> make_benchmarks(const Inputs &inputs) {
+    // The passes outlive this function, so they only capture the inputs
+    const auto n = inputs.positions.size();
+
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"singles", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.get_us().singles());
+                              }
+                          }});
+
+    benchmarks.push_back({"doubles", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.get_us().doubles());
+                              }
+                          }});
+
+    benchmarks.push_back({"count_legal_moves", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.count_legal_moves());
+                              }
+                          }});
+
+    benchmarks.push_back({"legal_moves", n, [&inputs]() {
+                              libataxx::Move movelist[libataxx::max_moves];
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.legal_moves(movelist));
+                                  clobber_memory();
+                              }
+                          }});
+
+    benchmarks.push_back({"board_count_legal_moves", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(board.count_legal_moves(inputs.positions[i]));
+                              }
+                          }});
+
+    benchmarks.push_back({"board_legal_moves", n, [&inputs]() {
+                              libataxx::Move movelist[libataxx::max_moves];
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(board.legal_moves(inputs.positions[i], movelist));
+                                  clobber_memory();
+                              }
+                          }});
+
+    benchmarks.push_back({"legal_captures", n, [&inputs]() {
+                              libataxx::Move movelist[libataxx::max_moves];
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.legal_captures(movelist));
+                                  clobber_memory();
+                              }
+                          }});
+
+    benchmarks.push_back({"makemove<true>", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  auto npos = inputs.positions[i];
+                                  npos.makemove<true>(inputs.moves[i]);
+                                  do_not_optimize(npos);
+                              }
+                          }});
+
+    benchmarks.push_back({"makemove<false>", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  auto npos = inputs.positions[i];
+                                  npos.makemove<false>(inputs.moves[i]);
+                                  do_not_optimize(npos);
+                              }
+                          }});
+
+    benchmarks.push_back({"predict_hash", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  do_not_optimize(inputs.positions[i].predict_hash(inputs.moves[i]));
+                              }
+                          }});
+
+    benchmarks.push_back({"calculate_hash", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.calculate_hash());
+                              }
+                          }});
+
+    benchmarks.push_back({"board_calculate_hash", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(board.calculate_hash(inputs.positions[i]));
+                              }
+                          }});
+
+    benchmarks.push_back({"get_minimal_hash", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.get_minimal_hash());
+                              }
+                          }});
+
+    benchmarks.push_back({"board_get_minimal_hash", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(inputs.positions[i].get_minimal_hash(board.symmetry_mask()));
+                              }
+                          }});
+
+    benchmarks.push_back({"canonical_hash", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(libataxx::canonical_hash(pos));
+                              }
+                          }});
+
+    benchmarks.push_back({"canonical_hash(all)", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(libataxx::canonical_hash(pos, libataxx::all_symmetries));
+                              }
+                          }});
+
+    benchmarks.push_back({"board_canonical_hash", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(libataxx::canonical_hash(inputs.positions[i], board.symmetry_mask()));
+                              }
+                          }});
+
+    benchmarks.push_back({"get_reachable", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.get_reachable());
+                              }
+                          }});
+
+    benchmarks.push_back({"board_get_reachable", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(board.get_reachable(inputs.positions[i]));
+                              }
+                          }});
+
+    benchmarks.push_back({"get_reachable(side)", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  do_not_optimize(pos.get_reachable(pos.get_turn()));
+                              }
+                          }});
+
+    benchmarks.push_back({"board_get_reachable(side)", n, [&inputs]() {
+                              for (std::size_t i = 0; i < inputs.positions.size(); ++i) {
+                                  const auto &pos = inputs.positions[i];
+                                  const auto &board = inputs.boards[inputs.layouts[i]];
+                                  do_not_optimize(board.get_reachable(pos, pos.get_turn()));
+                              }
+                          }});
+
+    benchmarks.push_back({"set_fen", n, [&inputs]() {
+                              libataxx::Position pos;
+                              for (const auto &fen : inputs.fens) {
+                                  do_not_optimize(pos.set_fen(fen));
+                                  do_not_optimize(pos);
+                              }
+                          }});
+
+    benchmarks.push_back({"get_fen", n, [&inputs]() {
+                              for (const auto &pos : inputs.positions) {
+                                  const auto fen = pos.get_fen();
+                                  do_not_optimize(fen);
+                              }
+                          }});
+
+    benchmarks.push_back({"pgn_write", inputs.games.size(), [&inputs]() {
+                              for (const auto &pgn : inputs.games) {
+                                  std::ostringstream ss;
+                                  ss << pgn;
+                                  do_not_optimize(ss);
+                              }
+                          }});
+
+    return benchmarks;
+}
+
+[[nodiscard]] Result run(const Benchmark &benchmark, const Options &options, PerfCounters *perf) {
+    // Warm up caches and branch predictors before timing anything
+    benchmark.pass();
+
+    std::vector<double> samples;
+    for (int r = 0; r < options.repetitions; ++r) {
+        const auto t0 = steady_clock::now();
+        for (int i = 0; i < options.iterations; ++i) {
+            benchmark.pass();
+        }
+        const auto t1 = steady_clock::now();
+        const auto ns = duration_cast<nanoseconds>(t1 - t0).count();
+        samples.push_back(static_cast<double>(ns) / (benchmark.ops * options.iterations));
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = benchmark.name;
+    result.ops = static_cast<std::uint64_t>(benchmark.ops) * options.iterations;
+    result.min = samples.front();
+    result.median = samples[samples.size() / 2];
+    result.max = samples.back();
+
+    if (perf) {
+        perf->start();
+        for (int i = 0; i < options.iterations; ++i) {
+            benchmark.pass();
+        }
+        result.counters = perf->stop();
+    }
+
+    return result;
+}
+
+void write_json(std::ostream &os, const Options &options, const std::vector<Result> &results) {
+    os << "{\n";
+    os << "  \"context\": {\n";
+    os << "    \"positions\": " << options.positions << ",\n";
+    os << "    \"games\": " << options.games << ",\n";
+    os << "    \"iterations\": " << options.iterations << ",\n";
+    os << "    \"repetitions\": " << options.repetitions << "\n";
+    os << "  },\n";
+    os << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        os << "    {";
+        os << "\"name\": \"" << result.name << "\", ";
+        os << "\"iterations\": " << result.ops << ", ";
+        os << std::fixed << std::setprecision(3);
+        os << "\"real_time\": " << result.median << ", ";
+        os << "\"min_time\": " << result.min << ", ";
+        os << "\"max_time\": " << result.max << ", ";
+        if (result.counters) {
+            // Per operation, like the times
+            for (std::size_t j = 0; j < num_counters; ++j) {
+                if (const auto value = result.counters->values[j]) {
+                    os << "\"" << counter_names[j] << "\": " << static_cast<double>(*value) / result.ops << ", ";
+                }
+            }
+        }
+        os << "\"time_unit\": \"ns\"";
+        os << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n";
+    os << "}\n";
+}
+
+int main(int argc, char **argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-positions" && i + 1 < argc) {
+            options.positions = std::max(1ULL, std::stoull(argv[++i]));
+        } else if (key == "-games" && i + 1 < argc) {
+            options.games = std::max(1ULL, std::stoull(argv[++i]));
+        } else if (key == "-iterations" && i + 1 < argc) {
+            options.iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (key == "-json" && i + 1 < argc) {
+            options.json = argv[++i];
+        } else if (key == "-counters") {
+            options.counters = true;
+        } else {
+            std::cout << "Usage: microbench [-positions n] [-games n] [-iterations n] [-repetitions n]" << std::endl;
+            std::cout << "                  [-filter name] [-json file|-] [-counters]" << std::endl;
+            return 1;
+        }
+    }
+
+    const auto inputs = make_inputs(options);
+    const auto benchmarks = make_benchmarks(inputs);
+    const bool quiet = options.json == "-";
+
+    PerfCounters perf;
+    if (options.counters && !perf.available()) {
+        (quiet ? std::cerr : std::cout) << "Hardware counters unavailable" << std::endl;
+        options.counters = false;
+    }
+
+    if (!quiet) {
+        std::cout << std::left << std::setw(28) << "Benchmark";
+        std::cout << std::right << std::setw(14) << "Iterations";
+        std::cout << std::setw(12) << "Median" << std::setw(12) << "Min" << std::setw(12) << "Max" << std::endl;
+    }
+
+    std::vector<Result> results;
+    for (const auto &benchmark : benchmarks) {
+        if (benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        const auto result = run(benchmark, options, options.counters ? &perf : nullptr);
+        results.push_back(result);
+
+        if (!quiet) {
+            std::cout << std::left << std::setw(28) << result.name;
+            std::cout << std::right << std::setw(14) << result.ops;
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << std::setw(10) << result.median << "ns";
+            std::cout << std::setw(10) << result.min << "ns";
+            std::cout << std::setw(10) << result.max << "ns" << std::endl;
+            if (result.counters) {
+                std::cout << "    ";
+                print_ratios(std::cout, *result.counters, result.ops, "op");
+                std::cout << std::endl;
+            }
+        }
+    }
+
+    if (quiet) {
+        write_json(std::cout, options, results);
+    } else if (!options.json.empty()) {
+        std::ofstream fs(options.json);
+        write_json(fs, options, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <libataxx/position.hpp>
+#include <libataxx/position_set.hpp>
+#include <libataxx/search.hpp>
+#include <libataxx/symmetry.hpp>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fens.hpp"
+#include "layouts.hpp"
+
+using namespace std::chrono;
+
+struct Options {
+    int threads = std::max(1U, std::thread::hardware_concurrency());
+    int count = 1000;
+    std::string out = "openings.epd";
+    std::string layouts = "symmetric";
+    int max_gaps = 8;
+    int num_random_layouts = 1000;
+    int plies = 4;
+    int depth = 4;
+    int window = 100;
+    std::uint64_t seed = 0;
+    // Positions generated before giving up, zero for 1000 per opening
+    std::uint64_t max_tries = 0;
+};
+
+[[nodiscard]] std::vector<libataxx::Bitboard> make_layouts(const Options &options, std::mt19937_64 &rng) {
+    if (options.layouts == "benchmark") {
+        std::vector<libataxx::Bitboard> layouts;
+        for (const auto &fen : benchmark_fens) {
+            layouts.push_back(libataxx::Position{fen}.get_gaps());
+        }
+        return layouts;
+    }
+    if (options.layouts == "random") {
+        return random_layouts(options.num_random_layouts, options.max_gaps, rng);
+    }
+    return symmetric_layouts(options.max_gaps);
+}
+
+class Output {
+   public:
+    Output(std::ostream &os, const int count) : os_{os}, count_{count} {
+    }
+
+    [[nodiscard]] bool done() const noexcept {
+        return written_ >= count_;
+    }
+
+    void add(const libataxx::Position &pos, const int score) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (written_ >= count_) {
+            return;
+        }
+        char fen[libataxx::Position::fen_buffer_size];
+        os_.write(fen, pos.write_fen(fen) - fen);
+        os_ << " ; sc " << score << "\n";
+        written_++;
+    }
+
+    [[nodiscard]] int written() const noexcept {
+        return written_;
+    }
+
+   private:
+    std::mutex mtx_;
+    std::ostream &os_;
+    int count_;
+    std::atomic<int> written_ = 0;
+};
+
+void worker(const Options &options,
+            const int id,
+            const std::vector<libataxx::Bitboard> &layouts,
+            libataxx::PositionSet &seen,
+            Output &output,
+            std::atomic<std::uint64_t> &tried) {
+    std::mt19937_64 rng(options.seed + 1 + id);
+    libataxx::search::Search search{4};
+    libataxx::search::Limits limits;
+    limits.depth = options.depth;
+    libataxx::Move moves[libataxx::max_moves];
+
+    // Too narrow a window or too few layouts can leave too few positions to
+    // ever reach the count
+    while (!output.done() && tried++ < options.max_tries) {
+        auto pos = libataxx::Position{"startpos"};
+        for (const auto &sq : layouts[rng() % layouts.size()]) {
+            pos.set(sq, libataxx::Piece::Gap);
+        }
+        pos.recalculate_hash();
+
+        for (int i = 0; i < options.plies && !pos.is_gameover(); ++i) {
+            const int num_moves = pos.legal_moves(moves);
+            pos.makemove(moves[rng() % num_moves]);
+        }
+
+        if (pos.is_gameover() || pos.must_pass()) {
+            continue;
+        }
+
+        // Keep positions that are close to equal after a short search
+        const auto result = search.go(pos, limits);
+        if (std::abs(result.score) > options.window) {
+            continue;
+        }
+
+        if (seen.insert(pos)) {
+            output.add(pos, result.score);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    Options options;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string key = argv[i];
+        const std::string value = argv[i + 1];
+        if (key == "-threads") {
+            options.threads = std::max(1, std::stoi(value));
+        } else if (key == "-count") {
+            options.count = std::stoi(value);
+        } else if (key == "-out") {
+            options.out = value;
+        } else if (key == "-layouts") {
+            options.layouts = value;
+        } else if (key == "-gaps") {
+            options.max_gaps = std::stoi(value);
+        } else if (key == "-random") {
+            options.num_random_layouts = std::stoi(value);
+        } else if (key == "-plies") {
+            options.plies = std::stoi(value);
+        } else if (key == "-depth") {
+            options.depth = std::stoi(value);
+        } else if (key == "-window") {
+            options.window = std::stoi(value);
+        } else if (key == "-seed") {
+            options.seed = std::stoull(value);
+        } else if (key == "-max-tries") {
+            options.max_tries = std::stoull(value);
+        } else {
+            std::cerr << "Unknown option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream fs(options.out);
+    if (!fs.is_open()) {
+        std::cerr << "Could not open " << options.out << std::endl;
+        return 1;
+    }
+
+    if (options.max_tries == 0) {
+        options.max_tries = 1000 * static_cast<std::uint64_t>(std::max(1, options.count));
+    }
+
+    std::mt19937_64 rng(options.seed);
+    const auto layouts = make_layouts(options, rng);
+    if (layouts.empty()) {
+        std::cerr << "No gap layouts" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Layouts: " << layouts.size() << std::endl;
+    std::cout << "Threads: " << options.threads << std::endl;
+    std::cout << "Output: " << options.out << std::endl;
+
+    libataxx::PositionSet seen;
+    Output output{fs, options.count};
+    std::atomic<std::uint64_t> tried = 0;
+    std::vector<std::thread> threads;
+
+    const auto t0 = steady_clock::now();
+    for (int i = 0; i < options.threads; ++i) {
+        threads.emplace_back(
+            worker, std::cref(options), i, std::cref(layouts), std::ref(seen), std::ref(output), std::ref(tried));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    const auto t1 = steady_clock::now();
+
+    std::cout << "Openings: " << output.written() << std::endl;
+    std::cout << "Tried: " << std::min<std::uint64_t>(tried, options.max_tries) << std::endl;
+    std::cout << "Time: " << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+
+    if (!output.done()) {
+        std::cerr << "Gave up after " << options.max_tries << " tries with " << output.written() << " of "
+                  << options.count << " openings" << std::endl;
+    }
+
+    return 0;
+}
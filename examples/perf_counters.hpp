@@ -0,0 +1,183 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class Counter : int
+{
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    L1DMisses,
+    LLCMisses,
+};
+
+constexpr std::size_t num_counters = 5;
+
+constexpr std::array<const char *, num_counters> counter_names = {
+    "cycles",
+    "instructions",
+    "branch-misses",
+    "L1d-misses",
+    "LLC-misses",
+};
+
+// Counts for one measured region, missing if the counter couldn't be opened
+struct CounterSample {
+    [[nodiscard]] std::optional<std::uint64_t> get(const Counter counter) const noexcept {
+        return values[static_cast<int>(counter)];
+    }
+
+    std::array<std::optional<std::uint64_t>, num_counters> values;
+};
+
+// Hardware counters for the calling thread and the threads it starts later
+// Counters are opened one at a time, so one the CPU or kernel refuses leaves
+// the rest working, and the counts it couldn't get are reported as missing
+class PerfCounters {
+   public:
+    PerfCounters() {
+#if defined(__linux__)
+        constexpr std::uint64_t cache_miss = PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+        const std::pair<std::uint32_t, std::uint64_t> events[num_counters] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_miss},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | cache_miss},
+        };
+
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = events[i].first;
+            attr.config = events[i].second;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            // User space only, which is all an unprivileged process gets
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds_[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const auto fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    [[nodiscard]] bool available() const noexcept {
+        for (const auto fd : fds_) {
+            if (fd >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void start() noexcept {
+#if defined(__linux__)
+        for (const auto fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] CounterSample stop() noexcept {
+        CounterSample sample;
+#if defined(__linux__)
+        for (const auto fd : fds_) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            // value, time enabled, time running
+            std::uint64_t data[3] = {};
+            if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+                continue;
+            }
+
+            // Scale up counts from counters that were multiplexed
+            const auto scale = static_cast<double>(data[1]) / data[2];
+            sample.values[i] = static_cast<std::uint64_t>(data[0] * scale);
+        }
+#endif
+        return sample;
+    }
+
+    // Runs f with the counters enabled
+    template <typename F>
+    [[nodiscard]] auto measure(F f, CounterSample &sample) {
+        start();
+        const auto result = f();
+        sample = stop();
+        return result;
+    }
+
+   private:
+    std::array<int, num_counters> fds_ = {-1, -1, -1, -1, -1};
+};
+
+// "cycles/node 12.3 IPC 2.10 branch-misses/node 0.45 ..."
+inline void print_ratios(std::ostream &os,
+                         const CounterSample &sample,
+                         const std::uint64_t nodes,
+                         const std::string &unit = "node") {
+    const auto per_node = [&](const Counter counter) -> std::string {
+        const auto value = sample.get(counter);
+        if (!value || nodes == 0) {
+            return "n/a";
+        }
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(2) << static_cast<double>(*value) / nodes;
+        return ss.str();
+    };
+
+    const auto cycles = sample.get(Counter::Cycles);
+    const auto instructions = sample.get(Counter::Instructions);
+    std::ostringstream ipc;
+    if (cycles && instructions && *cycles > 0) {
+        ipc << std::fixed << std::setprecision(2) << static_cast<double>(*instructions) / *cycles;
+    } else {
+        ipc << "n/a";
+    }
+
+    os << "cycles/" << unit << " " << per_node(Counter::Cycles);
+    os << " instructions/" << unit << " " << per_node(Counter::Instructions);
+    os << " IPC " << ipc.str();
+    os << " branch-misses/" << unit << " " << per_node(Counter::BranchMisses);
+    os << " L1d-misses/" << unit << " " << per_node(Counter::L1DMisses);
+    os << " LLC-misses/" << unit << " " << per_node(Counter::LLCMisses);
+}
+
+#endif
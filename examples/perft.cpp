@@ -1,12 +1,24 @@
 #include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <libataxx/libataxx.hpp>
+#include "perf_counters.hpp"
 
 using namespace std::chrono;
 
 int main(int argc, char **argv) {
     int depth = 6;
     std::string fen = "startpos";
+    bool counters = false;
+    bool breakdown = false;
+
+    // Flags are optional and come first
+    while (argc > 1 && (std::string(argv[1]) == "-counters" || std::string(argv[1]) == "-breakdown")) {
+        counters = counters || std::string(argv[1]) == "-counters";
+        breakdown = breakdown || std::string(argv[1]) == "-breakdown";
+        argv++;
+        argc--;
+    }
 
     if (argc > 1) {
         depth = std::stoi(argv[1]);
@@ -19,6 +31,12 @@ int main(int argc, char **argv) {
         }
     }
 
+    PerfCounters perf;
+    if (counters && !perf.available()) {
+        std::cout << "Hardware counters unavailable" << std::endl;
+        counters = false;
+    }
+
     const auto pos = libataxx::Position(fen);
 
     std::cout << "FEN: " << fen << std::endl;
@@ -28,9 +46,30 @@ int main(int argc, char **argv) {
     std::cout << pos << std::endl;
     std::cout << std::endl;
 
+    // Every ply comes out of one search
+    if (breakdown) {
+        const auto t0 = high_resolution_clock::now();
+        const auto stats = pos.perft_stats(depth);
+        const auto t1 = high_resolution_clock::now();
+
+        std::cout << "Depth        Nodes      Singles      Doubles   Passes     Captures        Flips  Gameovers"
+                     "   Black   White   Draws\n";
+        for (std::size_t i = 0; i < stats.size(); ++i) {
+            const auto &s = stats[i];
+            std::cout << std::setw(5) << i + 1;
+            std::cout << std::setw(13) << s.nodes << std::setw(13) << s.singles << std::setw(13) << s.doubles;
+            std::cout << std::setw(9) << s.passes << std::setw(13) << s.captures << std::setw(13) << s.flips;
+            std::cout << std::setw(11) << s.gameovers << std::setw(8) << s.black_wins << std::setw(8) << s.white_wins;
+            std::cout << std::setw(8) << s.draws << "\n";
+        }
+        std::cout << "time " << duration_cast<milliseconds>(t1 - t0).count() << "ms" << std::endl;
+        return 0;
+    }
+
     for (int i = 0; i <= depth; ++i) {
+        CounterSample sample;
         const auto t0 = high_resolution_clock::now();
-        const auto nodes = pos.perft(i);
+        const auto nodes = counters ? perf.measure([&]() { return pos.perft(i); }, sample) : pos.perft(i);
         const auto t1 = high_resolution_clock::now();
         const auto diff = duration_cast<milliseconds>(t1 - t0);
 
@@ -41,6 +80,10 @@ int main(int argc, char **argv) {
             const auto nps = 1000 * nodes / diff.count();
             std::cout << " nps " << nps;
         }
+        if (counters) {
+            std::cout << " ";
+            print_ratios(std::cout, sample, nodes);
+        }
         std::cout << std::endl;
     }
 
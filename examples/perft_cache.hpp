@@ -0,0 +1,192 @@
+#ifndef PERFT_CACHE_HPP
+#define PERFT_CACHE_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <libataxx/position.hpp>
+#include <stdexcept>
+#include <string>
+
+// Perft counts kept in a memory mapped file, so they survive the process and
+// an interrupted run picks up where it left off
+//
+// Entries are two words, the packed data and the key xor the data, written
+// without locks. A torn write from another thread, a collision on another
+// depth or a corrupted page all fail the xor check and read as a miss
+class PerftCache {
+   public:
+    PerftCache(const std::string &path, const std::size_t mb) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Could not open " + path);
+        }
+
+        struct stat st {};
+        ::fstat(fd_, &st);
+        const bool fresh = st.st_size == 0;
+
+        // An existing cache keeps its size
+        if (fresh) {
+            num_buckets_ = std::max<std::size_t>(1, mb * 1024 * 1024 / sizeof(Bucket));
+            size_ = sizeof(Header) + num_buckets_ * sizeof(Bucket);
+            if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+                ::close(fd_);
+                throw std::runtime_error("Could not resize " + path);
+            }
+        } else {
+            size_ = static_cast<std::size_t>(st.st_size);
+        }
+
+        data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (data_ == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Could not map " + path);
+        }
+        ::madvise(data_, size_, MADV_RANDOM);
+
+        auto *header = static_cast<Header *>(data_);
+        if (fresh) {
+            std::memcpy(header->magic, magic, sizeof(header->magic));
+            header->fingerprint = fingerprint();
+            header->num_buckets = num_buckets_;
+        } else if (size_ < sizeof(Header) || std::memcmp(header->magic, magic, sizeof(header->magic)) != 0 ||
+                   size_ != sizeof(Header) + header->num_buckets * sizeof(Bucket)) {
+            ::munmap(data_, size_);
+            ::close(fd_);
+            throw std::runtime_error(path + " is not a perft cache");
+        } else if (header->fingerprint != fingerprint()) {
+            ::munmap(data_, size_);
+            ::close(fd_);
+            throw std::runtime_error(path + " was written with different hash keys");
+        }
+
+        num_buckets_ = header->num_buckets;
+        buckets_ = reinterpret_cast<Bucket *>(static_cast<char *>(data_) + sizeof(Header));
+    }
+
+    ~PerftCache() {
+        ::msync(data_, size_, MS_SYNC);
+        ::munmap(data_, size_);
+        ::close(fd_);
+    }
+
+    PerftCache(const PerftCache &) = delete;
+
+    PerftCache &operator=(const PerftCache &) = delete;
+
+    // Subtree counts also depend on the halfmove clock once the 50 move rule
+    // is in reach, positions symmetric to each other share their counts
+    // The symmetries are the position's get_symmetries(), the same for every
+    // position under the root
+    [[nodiscard]] static std::uint64_t key(const libataxx::Position &pos,
+                                           const int depth,
+                                           const std::uint8_t symmetries) noexcept {
+        auto hash = pos.get_minimal_hash(symmetries);
+        if (pos.get_halfmoves() + depth >= 100) {
+            hash ^= (pos.get_halfmoves() + 1) * 0x9E3779B97F4A7C15ULL;
+        }
+        return hash;
+    }
+
+    [[nodiscard]] bool probe(const std::uint64_t key, const int depth, std::uint64_t &nodes) const noexcept {
+        auto &bucket = buckets_[key % num_buckets_];
+        for (auto &entry : bucket.entries) {
+            const auto data = std::atomic_ref<std::uint64_t>(entry.data).load(std::memory_order_relaxed);
+            const auto check = std::atomic_ref<std::uint64_t>(entry.check).load(std::memory_order_relaxed);
+            if ((check ^ data) == key && static_cast<int>(data & 0xFF) == depth) {
+                nodes = data >> 8;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Replaces the shallowest entry in the bucket
+    void store(const std::uint64_t key, const int depth, const std::uint64_t nodes) noexcept {
+        if (nodes >= (1ULL << 56)) {
+            return;
+        }
+
+        auto &bucket = buckets_[key % num_buckets_];
+        Entry *replace = &bucket.entries[0];
+        int replace_depth = 256;
+        for (auto &entry : bucket.entries) {
+            const auto data = std::atomic_ref<std::uint64_t>(entry.data).load(std::memory_order_relaxed);
+            const auto check = std::atomic_ref<std::uint64_t>(entry.check).load(std::memory_order_relaxed);
+            // Empty entries have depth 0
+            const int entry_depth = static_cast<int>(data & 0xFF);
+            if ((check ^ data) == key) {
+                replace = &entry;
+                break;
+            }
+            if (entry_depth < replace_depth) {
+                replace = &entry;
+                replace_depth = entry_depth;
+            }
+        }
+
+        const auto data = nodes << 8 | static_cast<std::uint64_t>(depth);
+        std::atomic_ref<std::uint64_t>(replace->data).store(data, std::memory_order_relaxed);
+        std::atomic_ref<std::uint64_t>(replace->check).store(key ^ data, std::memory_order_relaxed);
+    }
+
+    // Writes dirty pages back to the file
+    void flush() noexcept {
+        ::msync(data_, size_, MS_ASYNC);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return num_buckets_ * entries_per_bucket;
+    }
+
+    [[nodiscard]] std::size_t size_mb() const noexcept {
+        return size_ / (1024 * 1024);
+    }
+
+   private:
+    static constexpr char magic[8] = {'A', 'T', 'X', 'P', 'E', 'R', 'F', '1'};
+    static constexpr std::size_t entries_per_bucket = 4;
+
+    struct Header {
+        char magic[8];
+        std::uint64_t fingerprint;
+        std::uint64_t num_buckets;
+        // Keeps the buckets on cache line boundaries
+        std::uint64_t reserved[5];
+    };
+
+    struct Entry {
+        // Nodes in the upper 56 bits, depth in the lower 8
+        std::uint64_t data;
+        std::uint64_t check;
+    };
+
+    // One cache line
+    struct alignas(64) Bucket {
+        Entry entries[entries_per_bucket];
+    };
+
+    static_assert(sizeof(Header) == 64);
+    static_assert(sizeof(Bucket) == 64);
+
+    // Counts keyed by hashes from other zobrist keys would be wrong
+    [[nodiscard]] static std::uint64_t fingerprint() noexcept {
+        const auto a = libataxx::Position{"startpos"};
+        const auto b = libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1"};
+        return a.get_hash() ^ (b.get_hash() * 3);
+    }
+
+    int fd_ = -1;
+    void *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t num_buckets_ = 0;
+    Bucket *buckets_ = nullptr;
+};
+
+#endif
@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <libataxx/position.hpp>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fens.hpp"
+
+using namespace std::chrono;
+
+// Deepest depth stored when generating
+constexpr int max_depth = 6;
+
+// Depths are stored while their count stays below this
+constexpr std::uint64_t generate_node_limit = 250000000;
+
+// The quick profile only checks depths with at most this many nodes
+constexpr std::uint64_t quick_node_limit = 1000000;
+
+struct Entry {
+    std::string fen;
+    // nodes[0] is depth 1
+    std::vector<std::uint64_t> nodes;
+};
+
+// "x5o/7/7/7/7/7/o5x x 0 1 ;D1 16 ;D2 256 ;D3 6460"
+[[nodiscard]] std::vector<Entry> load(const std::string &path) {
+    std::ifstream fs(path);
+    if (!fs.is_open()) {
+        throw std::runtime_error("Could not open " + path);
+    }
+
+    std::vector<Entry> entries;
+    std::string line;
+    while (std::getline(fs, line)) {
+        const auto semicolon = line.find(';');
+        if (line.empty() || line[0] == '#' || semicolon == std::string::npos) {
+            continue;
+        }
+
+        Entry entry;
+        entry.fen = line.substr(0, semicolon);
+        while (!entry.fen.empty() && entry.fen.back() == ' ') {
+            entry.fen.pop_back();
+        }
+
+        std::stringstream ss{line.substr(semicolon)};
+        std::string field;
+        while (ss >> field) {
+            // ";D3" followed by the count
+            if (field.size() < 3 || field[0] != ';' || field[1] != 'D') {
+                throw std::invalid_argument("Invalid perft field " + field + " in " + line);
+            }
+            const auto depth = std::stoul(field.substr(2));
+            std::uint64_t count = 0;
+            if (depth != entry.nodes.size() + 1 || !(ss >> count)) {
+                throw std::invalid_argument("Invalid perft depths in " + line);
+            }
+            entry.nodes.push_back(count);
+        }
+
+        if (!libataxx::Position::from_fen(entry.fen)) {
+            throw std::invalid_argument("Invalid FEN " + entry.fen);
+        }
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+[[nodiscard]] libataxx::Position random_layout(std::mt19937_64 &rng) {
+    const auto corners = libataxx::Bitboard{libataxx::Bitmask::Corners};
+    const auto black = libataxx::Bitboard{(1ULL << 48) | (1ULL << 6)};
+    const auto white = corners ^ black;
+
+    // Up to 16 gaps anywhere but the corners
+    libataxx::Bitboard gaps;
+    const int num_gaps = rng() % 17;
+    for (int i = 0; i < num_gaps; ++i) {
+        const auto sq = libataxx::Square{libataxx::File(rng() % 7), libataxx::Rank(rng() % 7)};
+        gaps |= libataxx::Bitboard{sq};
+    }
+    gaps &= ~corners;
+
+    auto pos = libataxx::Position{black, white, gaps, 0, 1, libataxx::Side::Black};
+    pos.recalculate_hash();
+    return pos;
+}
+
+// Plays random moves and hands every position reached to f until it returns false
+template <typename F>
+void playout(libataxx::Position pos, std::mt19937_64 &rng, F f) {
+    libataxx::Move moves[libataxx::max_moves];
+    while (!pos.is_gameover() && f(pos)) {
+        const int num_moves = pos.legal_moves(moves);
+        pos.makemove(moves[rng() % num_moves]);
+    }
+}
+
+[[nodiscard]] std::vector<libataxx::Position> generate_positions(const std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<libataxx::Position> positions;
+
+    // The benchmark layouts and some random ones, with either side to move
+    std::vector<libataxx::Position> layouts;
+    for (const auto &fen : benchmark_fens) {
+        layouts.emplace_back(fen);
+    }
+    while (layouts.size() < 60) {
+        layouts.push_back(random_layout(rng));
+    }
+    for (const auto &layout : layouts) {
+        positions.push_back(layout);
+        auto flipped = layout;
+        flipped.set_turn(libataxx::Side::White);
+        flipped.recalculate_hash();
+        positions.push_back(flipped);
+    }
+
+    // Openings and middlegames
+    for (int i = 0; i < 120; ++i) {
+        const auto &layout = layouts[rng() % layouts.size()];
+        const int plies = 2 + rng() % 40;
+        int ply = 0;
+        playout(layout, rng, [&](const libataxx::Position &pos) {
+            if (ply++ == plies) {
+                positions.push_back(pos);
+                return false;
+            }
+            return true;
+        });
+    }
+
+    // Nearly full boards and positions where one side has to pass
+    int endgames = 0;
+    int passes = 0;
+    while (endgames < 60 || passes < 40) {
+        const auto &layout = layouts[rng() % layouts.size()];
+        playout(layout, rng, [&](const libataxx::Position &pos) {
+            const auto empty = pos.get_empty().count();
+            if (passes < 40 && pos.must_pass()) {
+                positions.push_back(pos);
+                passes++;
+                return false;
+            }
+            if (endgames < 60 && empty <= 8 && rng() % 4 == 0) {
+                positions.push_back(pos);
+                endgames++;
+                return false;
+            }
+            return true;
+        });
+    }
+
+    // Close to the 50 move rule
+    for (int i = 0; i < 20; ++i) {
+        const auto &base = positions[rng() % positions.size()];
+        auto pos = libataxx::Position{base.get_black(),
+                                      base.get_white(),
+                                      base.get_gaps(),
+                                      97U + static_cast<unsigned int>(rng() % 3),
+                                      base.get_fullmoves(),
+                                      base.get_turn()};
+        pos.recalculate_hash();
+        positions.push_back(pos);
+    }
+
+    return positions;
+}
+
+void generate(const std::string &path, const std::uint64_t seed, const int threads) {
+    const auto positions = generate_positions(seed);
+    std::vector<Entry> entries(positions.size());
+    std::atomic<std::size_t> next = 0;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (auto i = next++; i < positions.size(); i = next++) {
+                const auto &pos = positions[i];
+                entries[i].fen = pos.get_fen();
+                std::uint64_t previous = 1;
+                for (int depth = 1; depth <= max_depth; ++depth) {
+                    const auto nodes = pos.perft(depth);
+                    entries[i].nodes.push_back(nodes);
+
+                    // Guess the next count from the current branching factor
+                    if (nodes == 0 || nodes * nodes / previous > generate_node_limit) {
+                        break;
+                    }
+                    previous = nodes;
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    std::ofstream fs(path);
+    fs << "# Perft counts from depth 1, generated by perftsuite -generate with seed " << seed << "\n";
+    for (const auto &entry : entries) {
+        fs << entry.fen;
+        for (std::size_t d = 0; d < entry.nodes.size(); ++d) {
+            fs << " ;D" << d + 1 << " " << entry.nodes[d];
+        }
+        fs << "\n";
+    }
+
+    std::cout << "Wrote " << entries.size() << " positions to " << path << std::endl;
+}
+
+struct Outcome {
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    microseconds time{0};
+    bool passed = true;
+    std::string error;
+};
+
+[[nodiscard]] Outcome verify(const Entry &entry, const std::uint64_t node_limit, const int depth_limit) {
+    const auto pos = libataxx::Position{entry.fen};
+    Outcome outcome;
+
+    const auto t0 = steady_clock::now();
+    for (std::size_t i = 0; i < entry.nodes.size(); ++i) {
+        const int depth = static_cast<int>(i) + 1;
+        if (depth > depth_limit || (depth > 1 && entry.nodes[i] > node_limit)) {
+            break;
+        }
+
+        const auto nodes = pos.perft(depth);
+        outcome.depth = depth;
+        outcome.nodes += nodes;
+        if (nodes != entry.nodes[i]) {
+            outcome.passed = false;
+            outcome.error = "depth " + std::to_string(depth) + " expected " + std::to_string(entry.nodes[i]) +
+                            " got " + std::to_string(nodes);
+            break;
+        }
+    }
+    outcome.time = duration_cast<microseconds>(steady_clock::now() - t0);
+
+    return outcome;
+}
+
+int main(int argc, char **argv) {
+    std::string path = "perft.epd";
+    std::string profile = "full";
+    std::string generate_path;
+    std::uint64_t seed = 0;
+    int threads = std::max(1U, std::thread::hardware_concurrency());
+    int depth_limit = max_depth;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-file" && i + 1 < argc) {
+            path = argv[++i];
+        } else if (key == "-profile" && i + 1 < argc) {
+            profile = argv[++i];
+        } else if (key == "-threads" && i + 1 < argc) {
+            threads = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-depth" && i + 1 < argc) {
+            depth_limit = std::stoi(argv[++i]);
+        } else if (key == "-generate" && i + 1 < argc) {
+            generate_path = argv[++i];
+        } else if (key == "-seed" && i + 1 < argc) {
+            seed = std::stoull(argv[++i]);
+        } else if (key == "-verbose") {
+            verbose = true;
+        } else {
+            std::cout << "Usage: perftsuite [-file perft.epd] [-profile quick|full] [-threads n] [-depth n] [-verbose]"
+                      << std::endl;
+            std::cout << "       perftsuite -generate perft.epd [-seed n] [-threads n]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!generate_path.empty()) {
+        generate(generate_path, seed, threads);
+        return 0;
+    }
+
+    if (profile != "quick" && profile != "full") {
+        std::cerr << "Unknown profile " << profile << std::endl;
+        return 1;
+    }
+    const auto node_limit = profile == "quick" ? quick_node_limit : std::numeric_limits<std::uint64_t>::max();
+
+    std::vector<Entry> entries;
+    try {
+        entries = load(path);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<Outcome> outcomes(entries.size());
+    std::atomic<std::size_t> next = 0;
+    std::mutex mtx;
+
+    const auto t0 = steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            for (auto i = next++; i < entries.size(); i = next++) {
+                outcomes[i] = verify(entries[i], node_limit, depth_limit);
+                const auto &outcome = outcomes[i];
+                if (!verbose && outcome.passed) {
+                    continue;
+                }
+
+                const auto us = std::max<std::int64_t>(1, outcome.time.count());
+                std::lock_guard<std::mutex> lock(mtx);
+                std::cout << std::left << std::setw(5) << i + 1;
+                std::cout << (outcome.passed ? "ok    " : "FAIL  ");
+                std::cout << "depth " << outcome.depth;
+                std::cout << std::right << std::setw(13) << outcome.nodes << " nodes";
+                std::cout << std::setw(9) << outcome.time.count() / 1000 << "ms";
+                std::cout << std::setw(7) << outcome.nodes / us << " Mnps  ";
+                std::cout << entries[i].fen;
+                if (!outcome.passed) {
+                    std::cout << "  " << outcome.error;
+                }
+                std::cout << std::endl;
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const auto elapsed = duration_cast<milliseconds>(steady_clock::now() - t0);
+
+    std::uint64_t nodes = 0;
+    int failed = 0;
+    for (const auto &outcome : outcomes) {
+        nodes += outcome.nodes;
+        failed += !outcome.passed;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Profile: " << profile << std::endl;
+    std::cout << "Positions: " << entries.size() << std::endl;
+    std::cout << "Failed: " << failed << std::endl;
+    std::cout << "Nodes: " << nodes << std::endl;
+    std::cout << "Time: " << elapsed.count() << "ms" << std::endl;
+    std::cout << "Nodes/s: " << 1000 * nodes / std::max<std::int64_t>(1, elapsed.count()) << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
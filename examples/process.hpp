@@ -0,0 +1,121 @@
+#ifndef PROCESS_HPP
+#define PROCESS_HPP
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// A child process run through the shell with pipes to its stdin and stdout
+class Process {
+   public:
+    explicit Process(const std::string &command) {
+        // Close on exec from the start, so engines started by other threads
+        // never inherit them. dup2() clears the flag on the child's copies
+        int to_child[2];
+        int from_child[2];
+        if (::pipe2(to_child, O_CLOEXEC) != 0 || ::pipe2(from_child, O_CLOEXEC) != 0) {
+            throw std::runtime_error("Could not create pipes for " + command);
+        }
+
+        pid_ = ::fork();
+        if (pid_ < 0) {
+            throw std::runtime_error("Could not fork for " + command);
+        }
+
+        if (pid_ == 0) {
+            // dup2() onto the same descriptor leaves the flag alone
+            for (const auto &[fd, target] : {std::pair{to_child[0], STDIN_FILENO}, {from_child[1], STDOUT_FILENO}}) {
+                if (fd == target) {
+                    ::fcntl(fd, F_SETFD, 0);
+                } else {
+                    ::dup2(fd, target);
+                }
+            }
+            ::execl("/bin/sh", "sh", "-c", ("exec " + command).c_str(), static_cast<char *>(nullptr));
+            ::_exit(127);
+        }
+
+        ::close(to_child[0]);
+        ::close(from_child[1]);
+        in_ = to_child[1];
+        out_ = from_child[0];
+    }
+
+    ~Process() {
+        ::close(in_);
+        ::close(out_);
+        ::kill(pid_, SIGKILL);
+        ::waitpid(pid_, nullptr, 0);
+    }
+
+    Process(const Process &) = delete;
+
+    Process &operator=(const Process &) = delete;
+
+    // Returns false if the process has gone away
+    bool write_line(const std::string &line) noexcept {
+        const auto str = line + "\n";
+        std::size_t written = 0;
+        while (written < str.size()) {
+            const auto n = ::write(in_, str.data() + written, str.size() - written);
+            if (n <= 0) {
+                return false;
+            }
+            written += n;
+        }
+        return true;
+    }
+
+    // Returns nothing if no full line arrived before the deadline or the
+    // process has gone away
+    [[nodiscard]] std::optional<std::string> read_line(const std::chrono::steady_clock::time_point deadline) {
+        for (;;) {
+            const auto eol = buffer_.find('\n');
+            if (eol != std::string::npos) {
+                auto line = buffer_.substr(0, eol);
+                buffer_.erase(0, eol + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return line;
+            }
+
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) {
+                return std::nullopt;
+            }
+
+            pollfd pfd{out_, POLLIN, 0};
+            const int ready = ::poll(&pfd, 1, static_cast<int>(left.count()));
+            if (ready < 0) {
+                return std::nullopt;
+            }
+            if (ready == 0) {
+                continue;
+            }
+
+            char chunk[4096];
+            const auto n = ::read(out_, chunk, sizeof(chunk));
+            if (n <= 0) {
+                return std::nullopt;
+            }
+            buffer_.append(chunk, n);
+        }
+    }
+
+   private:
+    pid_t pid_ = -1;
+    int in_ = -1;
+    int out_ = -1;
+    std::string buffer_;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef QUEUE_HPP
+#define QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+
+// Bounded lock-free queue for many producers and consumers
+// Each cell carries a sequence number that tells producers and consumers
+// whether it is theirs to use, so the only contention is one CAS per operation
+template <class T>
+class Queue {
+   public:
+    explicit Queue(std::size_t capacity) {
+        // Round up to a power of two
+        std::size_t n = 2;
+        while (n < capacity) {
+            n *= 2;
+        }
+        mask_ = n - 1;
+        cells_ = std::make_unique<Cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] bool try_push(T &value) noexcept {
+        auto pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &cell = cells_[pos & mask_];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] std::optional<T> try_pop() noexcept {
+        auto pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &cell = cells_[pos & mask_];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::optional<T> value{std::move(cell.data)};
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return value;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Yields while the queue is full
+    void push(T value) noexcept {
+        while (!try_push(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+   private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> head_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_ = 0;
+};
+
+#endif
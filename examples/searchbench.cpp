@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <libataxx/position.hpp>
+#include <libataxx/search.hpp>
+#include <string>
+#include "fens.hpp"
+
+using namespace std::chrono;
+
+// Time to depth over the benchmark positions, for comparing search parameters
+// against each other or against plain alpha-beta
+int main(int argc, char **argv) {
+    int depth = 7;
+    std::size_t hash = 16;
+    bool verbose = false;
+    auto params = libataxx::search::Params{};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-depth" && i + 1 < argc) {
+            depth = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-hash" && i + 1 < argc) {
+            hash = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-nopruning") {
+            params = libataxx::search::no_pruning();
+        } else if (key == "-set" && i + 1 < argc) {
+            const std::string setting = argv[++i];
+            const auto eq = setting.find('=');
+            if (eq == std::string::npos ||
+                !libataxx::search::set_param(params, setting.substr(0, eq), std::stoi(setting.substr(eq + 1)))) {
+                std::cerr << "Unknown parameter " << setting << std::endl;
+                return 1;
+            }
+        } else if (key == "-verbose") {
+            verbose = true;
+        } else {
+            std::cout << "Usage: searchbench [-depth n] [-hash mb] [-nopruning] [-set name=value]... [-verbose]"
+                      << std::endl;
+            std::cout << "Parameters:";
+            for (const auto &info : libataxx::search::param_info) {
+                std::cout << " " << info.name;
+            }
+            std::cout << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Depth: " << depth << std::endl;
+    for (const auto &info : libataxx::search::param_info) {
+        std::cout << info.name << "=" << params.*info.value << " ";
+    }
+    std::cout << std::endl << std::endl;
+
+    libataxx::search::Search search{hash};
+    search.set_params(params);
+    libataxx::search::Limits limits;
+    limits.depth = depth;
+
+    std::uint64_t total_nodes = 0;
+    auto total_time = microseconds(0);
+
+    std::cout << "Pos       Nodes      Time   Score  Move  FEN" << std::endl;
+    for (std::size_t i = 0; i < benchmark_fens.size(); ++i) {
+        const auto pos = libataxx::Position{benchmark_fens.at(i)};
+
+        // Every position starts from an empty table
+        search.clear();
+        if (verbose) {
+            search.set_info_handler([](const libataxx::search::Info &info) {
+                std::cout << "  depth " << info.depth << " score " << info.score << " nodes " << info.nodes
+                          << " time " << info.time.count() << std::endl;
+            });
+        }
+
+        const auto t0 = steady_clock::now();
+        const auto result = search.go(pos, limits);
+        const auto t1 = steady_clock::now();
+        const auto dt = duration_cast<microseconds>(t1 - t0);
+
+        total_nodes += result.nodes;
+        total_time += dt;
+
+        std::cout << std::left << std::setw(4) << i + 1 << std::right;
+        std::cout << std::setw(11) << result.nodes;
+        std::cout << std::setw(8) << dt.count() / 1000 << "ms";
+        std::cout << std::setw(8) << result.score;
+        std::cout << "  " << std::left << std::setw(6) << static_cast<std::string>(result.bestmove) << std::right;
+        std::cout << benchmark_fens.at(i) << std::endl;
+    }
+
+    const auto ms = std::max<std::int64_t>(1, duration_cast<milliseconds>(total_time).count());
+    std::cout << std::endl;
+    std::cout << "Nodes: " << total_nodes << std::endl;
+    std::cout << "Time: " << ms << "ms" << std::endl;
+    std::cout << "NPS: " << total_nodes * 1000 / ms << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <libataxx/pgn.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/search.hpp>
+#include <libataxx/timeman.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// Replays the positions from a set of games with both sides on a simulated
+// clock, searching each one with the time manager's allocation and charging
+// the time taken, to compare time management policies without playing matches
+
+struct Stats {
+    int games = 0;
+    int moves = 0;
+    int flags = 0;
+    std::uint64_t depths = 0;
+    milliseconds used{0};
+    milliseconds longest{0};
+    // Clock left at the end of each game as a share of the starting time
+    double left = 0.0;
+    double min_left = 1.0;
+};
+
+[[nodiscard]] milliseconds parse_seconds(const std::string &str) {
+    return milliseconds(static_cast<long long>(1000 * std::stod(str)));
+}
+
+// "hardscale=2.5,incpercent=75"
+[[nodiscard]] libataxx::timeman::Policy parse_policy(const std::string &str) {
+    libataxx::timeman::Policy policy;
+    std::stringstream ss{str};
+    std::string setting;
+
+    while (std::getline(ss, setting, ',')) {
+        const auto eq = setting.find('=');
+        if (eq == std::string::npos) {
+            throw std::invalid_argument("Invalid policy setting " + setting);
+        }
+
+        const auto key = setting.substr(0, eq);
+        const auto value = setting.substr(eq + 1);
+        if (key == "overhead") {
+            policy.move_overhead = milliseconds(std::stoi(value));
+        } else if (key == "margin") {
+            policy.movestogo_margin = std::stoi(value);
+        } else if (key == "minmtg") {
+            policy.min_movestogo = std::stoi(value);
+        } else if (key == "maxmtg") {
+            policy.max_movestogo = std::stoi(value);
+        } else if (key == "incpercent") {
+            policy.inc_percent = std::stoi(value);
+        } else if (key == "hardscale") {
+            policy.hard_scale = std::stod(value);
+        } else if (key == "clockshare") {
+            policy.max_clock_share = std::stod(value);
+        } else if (key == "stability") {
+            policy.stability_step = std::stod(value);
+        } else if (key == "dropscale") {
+            policy.score_drop_scale = std::max(1, std::stoi(value));
+        } else {
+            throw std::invalid_argument("Unknown policy setting " + key);
+        }
+    }
+
+    return policy;
+}
+
+[[nodiscard]] Stats simulate(const std::vector<libataxx::pgn::PGN> &games,
+                             const libataxx::timeman::Policy &policy,
+                             const milliseconds time,
+                             const milliseconds inc,
+                             const std::size_t hash) {
+    Stats stats;
+    libataxx::search::Search search{hash};
+
+    for (const auto &game : games) {
+        auto pos = libataxx::pgn::start_position(game);
+        milliseconds clocks[2] = {time, time};
+        search.clear();
+
+        for (const auto &move : game.root().mainline()) {
+            if (pos.is_gameover() || !pos.is_legal_move(move)) {
+                break;
+            }
+
+            const int us = static_cast<int>(pos.get_turn());
+            const auto allocation = libataxx::timeman::allocate({clocks[us], inc, 0}, pos, policy);
+
+            libataxx::search::Limits limits;
+            limits.movetime = allocation.hard;
+            limits.soft = allocation.soft;
+
+            const auto t0 = steady_clock::now();
+            const auto result = search.go(pos, limits);
+            const auto dt = duration_cast<milliseconds>(steady_clock::now() - t0);
+
+            stats.moves++;
+            stats.depths += result.depth;
+            stats.used += dt;
+            stats.longest = std::max(stats.longest, dt);
+
+            clocks[us] -= dt;
+            if (clocks[us].count() < 0) {
+                stats.flags++;
+                break;
+            }
+            clocks[us] += inc;
+
+            // The game's own move is played so every policy sees the same positions
+            pos.makemove(move);
+        }
+
+        const double left =
+            static_cast<double>(std::min(clocks[0], clocks[1]).count()) / std::max<long long>(1, time.count());
+        stats.games++;
+        stats.left += left;
+        stats.min_left = std::min(stats.min_left, left);
+    }
+
+    return stats;
+}
+
+int main(int argc, char **argv) {
+    std::string path;
+    milliseconds time{10000};
+    milliseconds inc{100};
+    std::size_t hash = 16;
+    std::size_t max_games = 10;
+    std::vector<std::string> policies;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (key == "-pgn" && i + 1 < argc) {
+            path = argv[++i];
+        } else if (key == "-tc" && i + 1 < argc) {
+            const std::string tc = argv[++i];
+            const auto plus = tc.find('+');
+            time = parse_seconds(tc.substr(0, plus));
+            inc = plus == std::string::npos ? milliseconds(0) : parse_seconds(tc.substr(plus + 1));
+        } else if (key == "-hash" && i + 1 < argc) {
+            hash = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-games" && i + 1 < argc) {
+            max_games = std::max(1, std::stoi(argv[++i]));
+        } else if (key == "-policy" && i + 1 < argc) {
+            policies.emplace_back(argv[++i]);
+        } else {
+            std::cout << "Usage: tmsim -pgn games.pgn [-tc 10+0.1] [-hash mb] [-games n] [-policy a=1,b=2]..."
+                      << std::endl;
+            std::cout << "Policy settings: overhead margin minmtg maxmtg incpercent hardscale clockshare stability "
+                         "dropscale"
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    if (path.empty()) {
+        std::cerr << "No games given" << std::endl;
+        return 1;
+    }
+    if (policies.empty()) {
+        policies.emplace_back();
+    }
+
+    std::vector<libataxx::pgn::PGN> games;
+    try {
+        std::ifstream f{path};
+        if (!f) {
+            throw std::runtime_error("Could not open " + path);
+        }
+        while (games.size() < max_games) {
+            auto game = libataxx::pgn::read(f);
+            if (!game) {
+                break;
+            }
+            games.push_back(std::move(*game));
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Games: " << games.size() << std::endl;
+    std::cout << "TC: " << time.count() << "+" << inc.count() << "ms" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Moves  Flags  Depth  Avg ms  Max ms  Left  Min left  Policy" << std::endl;
+
+    for (const auto &str : policies) {
+        libataxx::timeman::Policy policy;
+        try {
+            policy = parse_policy(str);
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        const auto stats = simulate(games, policy, time, inc, hash);
+        const auto moves = std::max(1, stats.moves);
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::setw(5) << stats.moves;
+        std::cout << std::setw(7) << stats.flags;
+        std::cout << std::setw(7) << static_cast<double>(stats.depths) / moves;
+        std::cout << std::setw(8) << stats.used.count() / moves;
+        std::cout << std::setw(8) << stats.longest.count();
+        std::cout << std::setw(6) << stats.left / std::max(1, stats.games);
+        std::cout << std::setw(10) << stats.min_left;
+        std::cout << "  " << (str.empty() ? "default" : str) << std::endl;
+    }
+
+    return 0;
+}
@@ -9,7 +9,11 @@ struct TTEntry {
     std::uint8_t depth = 0;
 };
 
-[[nodiscard]] std::uint64_t ttperft(TT<TTEntry> &tt, const libataxx::Position &pos, const std::uint8_t depth) {
+// The gaps and so their symmetries are the same all the way down
+[[nodiscard]] std::uint64_t ttperft(TT<TTEntry> &tt,
+                                    const libataxx::Position &pos,
+                                    const std::uint8_t depth,
+                                    const std::uint8_t symmetries) {
     if (depth == 0) {
         return 1;
     }
@@ -17,7 +21,7 @@ struct TTEntry {
         return pos.count_legal_moves();
     }
 
-    const auto hash = pos.get_minimal_hash();
+    const auto hash = pos.get_minimal_hash(symmetries);
 
     // Poll TT
     const auto &entry = tt.poll(hash);
@@ -31,7 +35,7 @@ struct TTEntry {
 
     for (int i = 0; i < num_moves; ++i) {
         const auto npos = pos.after_move(moves[i]);
-        nodes += ttperft(tt, npos, depth - 1);
+        nodes += ttperft(tt, npos, depth - 1, symmetries);
     }
 
     // Create TT entry
@@ -76,7 +80,7 @@ int main(int argc, char **argv) {
 
     for (int i = 0; i <= depth; ++i) {
         const auto t0 = std::chrono::high_resolution_clock::now();
-        const auto nodes = ttperft(tt, pos, i);
+        const auto nodes = ttperft(tt, pos, i, pos.get_symmetries());
         const auto t1 = std::chrono::high_resolution_clock::now();
         const auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
 
@@ -0,0 +1,178 @@
+#include "libataxx/analysis.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace libataxx::analysis {
+
+void analyse(const std::vector<Position> &positions,
+             const Options &options,
+             const ResultHandler &handler,
+             const std::size_t first) {
+    if (first >= positions.size()) {
+        return;
+    }
+
+    std::atomic<std::size_t> next = first;
+    std::atomic<bool> failed = false;
+
+    // Finished positions wait here until every one before them has been handled
+    std::mutex mtx;
+    std::map<std::size_t, std::pair<search::Result, std::chrono::milliseconds>> pending;
+    std::size_t next_handled = first;
+    std::exception_ptr error;
+
+    const auto worker = [&]() {
+        search::Search search{options.hash_mb};
+        for (auto i = next++; i < positions.size() && !failed; i = next++) {
+            if (options.clear) {
+                search.clear();
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            auto result = search.go(positions[i], options.limits);
+            const auto dt =
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0);
+
+            const std::lock_guard<std::mutex> lock{mtx};
+            pending.emplace(i, std::make_pair(std::move(result), dt));
+            try {
+                for (auto it = pending.begin(); !failed && it != pending.end() && it->first == next_handled;) {
+                    handler(it->first, it->second.first, it->second.second);
+                    it = pending.erase(it);
+                    next_handled++;
+                }
+            } catch (...) {
+                error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    const auto num_threads =
+        std::clamp<std::size_t>(options.threads, 1, std::max<std::size_t>(1, positions.size() - first));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+[[nodiscard]] std::vector<search::Result> analyse(const std::vector<Position> &positions, const Options &options) {
+    std::vector<search::Result> results(positions.size());
+    analyse(positions, options, [&results](const std::size_t index, const search::Result &result, const auto) {
+        results[index] = result;
+    });
+    return results;
+}
+
+[[nodiscard]] Checkpoint read_checkpoint(const std::string &path) {
+    std::ifstream fs{path};
+    if (!fs.is_open()) {
+        return {};
+    }
+
+    Checkpoint checkpoint;
+    if (!(fs >> checkpoint.positions >> checkpoint.bytes)) {
+        throw std::runtime_error("Invalid checkpoint " + path);
+    }
+    return checkpoint;
+}
+
+void write_checkpoint(const std::string &path, const Checkpoint &checkpoint) {
+    const auto tmp = path + ".tmp";
+    {
+        std::ofstream fs{tmp, std::ios::trunc};
+        fs << checkpoint.positions << " " << checkpoint.bytes << std::endl;
+        if (!fs) {
+            throw std::runtime_error("Could not write " + tmp);
+        }
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+[[nodiscard]] std::string format_score(const int score, const int depth) {
+    std::string str;
+    if (score > search::mate_bound) {
+        str = "#" + std::to_string((search::mate_score - score + 1) / 2);
+    } else if (score < -search::mate_bound) {
+        str = "#-" + std::to_string((search::mate_score + score) / 2);
+    } else {
+        const int abs = std::abs(score);
+        const auto cents = std::to_string(abs % 100);
+        str = (score < 0 ? "-" : "+") + std::to_string(abs / 100) + "." + (cents.size() == 1 ? "0" : "") + cents;
+    }
+    return str + "/" + std::to_string(depth);
+}
+
+[[nodiscard]] std::string format_comment(const search::Result &result, const Move &played) {
+    if (result.lines.empty()) {
+        return {};
+    }
+
+    const auto &best = result.lines.front();
+    const auto line = std::find_if(
+        result.lines.begin(), result.lines.end(), [&played](const search::Line &l) { return l.move == played; });
+
+    std::string str;
+    if (line != result.lines.end()) {
+        str = format_score(line->score, line->depth);
+    }
+    if (line != result.lines.begin()) {
+        str += str.empty() ? "" : " ";
+        str += "best " + static_cast<std::string>(best.move) + " " + format_score(best.score, best.depth);
+    }
+
+    if (result.lines.size() > 1) {
+        str += " [";
+        for (std::size_t i = 0; i < result.lines.size(); ++i) {
+            const auto &l = result.lines[i];
+            if (i > 0) {
+                str += ", ";
+            }
+            str += static_cast<std::string>(l.move) + " " + format_score(l.score, l.depth);
+        }
+        str += "]";
+    }
+
+    return str;
+}
+
+void annotate(pgn::PGN &game, const Options &options) {
+    std::vector<Position> positions;
+    std::vector<pgn::Node *> nodes;
+
+    auto pos = pgn::start_position(game);
+    auto *node = game.root();
+    while (node->has_children()) {
+        node = &node->children().front();
+        if (pos.is_gameover() || !pos.is_legal_move(node->move())) {
+            break;
+        }
+        positions.push_back(pos);
+        nodes.push_back(node);
+        pos.makemove(node->move());
+    }
+
+    const auto results = analyse(positions, options);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        nodes[i]->add_comment(format_comment(results[i], nodes[i]->move()));
+    }
+}
+
+}  // namespace libataxx::analysis
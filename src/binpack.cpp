@@ -0,0 +1,448 @@
+#include "libataxx/binpack.hpp"
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace libataxx::binpack {
+
+namespace {
+
+constexpr char magic[4] = {'B', 'I', 'N', 'P'};
+constexpr std::uint16_t encoded_nomove = 0xFFFF;
+constexpr std::uint16_t encoded_nullmove = 0xFFFE;
+
+[[nodiscard]] std::uint16_t encode_move(const Move &move) noexcept {
+    if (move == Move::nomove()) {
+        return encoded_nomove;
+    }
+    if (move == Move::nullmove()) {
+        return encoded_nullmove;
+    }
+    return static_cast<std::uint16_t>(49 * move.from().index() + move.to().index());
+}
+
+[[nodiscard]] Move decode_move(const std::uint16_t n) {
+    if (n == encoded_nomove) {
+        return Move::nomove();
+    }
+    if (n == encoded_nullmove) {
+        return Move::nullmove();
+    }
+    if (n >= 49 * 49) {
+        throw std::runtime_error("binpack: invalid move");
+    }
+    const auto from = Square{(n / 49) % 7, (n / 49) / 7};
+    const auto to = Square{(n % 49) % 7, (n % 49) / 7};
+    return from == to ? Move(to) : Move(from, to);
+}
+
+void put_bytes(std::vector<std::uint8_t> &buf, std::uint64_t n, const int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        buf.push_back(n & 0xFF);
+        n >>= 8;
+    }
+}
+
+void put_varint(std::vector<std::uint8_t> &buf, std::uint64_t n) {
+    while (n >= 0x80) {
+        buf.push_back((n & 0x7F) | 0x80);
+        n >>= 7;
+    }
+    buf.push_back(n);
+}
+
+class Cursor {
+   public:
+    Cursor(const std::uint8_t *data, const std::size_t size) : data_{data}, size_{size} {
+    }
+
+    [[nodiscard]] bool done() const noexcept {
+        return idx_ >= size_;
+    }
+
+    [[nodiscard]] std::uint64_t bytes(const int n) {
+        if (idx_ + n > size_) {
+            throw std::runtime_error("binpack: unexpected end of chunk");
+        }
+        std::uint64_t result = 0;
+        for (int i = 0; i < n; ++i) {
+            result |= static_cast<std::uint64_t>(data_[idx_ + i]) << (8 * i);
+        }
+        idx_ += n;
+        return result;
+    }
+
+    [[nodiscard]] std::uint64_t varint() {
+        std::uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = bytes(1);
+            result |= (byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        throw std::runtime_error("binpack: invalid varint");
+    }
+
+   private:
+    const std::uint8_t *data_;
+    std::size_t size_;
+    std::size_t idx_ = 0;
+};
+
+[[nodiscard]] std::uint64_t zigzag(const int n) noexcept {
+    return (static_cast<std::uint64_t>(n) << 1) ^ static_cast<std::uint64_t>(n < 0 ? -1 : 0);
+}
+
+[[nodiscard]] int unzigzag(const std::uint64_t n) noexcept {
+    return static_cast<int>(n >> 1) ^ -static_cast<int>(n & 1);
+}
+
+[[nodiscard]] float relative_result(const TrainingEntry &entry) noexcept {
+    switch (entry.result) {
+        case Result::BlackWin:
+            return entry.pos.get_turn() == Side::Black ? 1.0f : 0.0f;
+        case Result::WhiteWin:
+            return entry.pos.get_turn() == Side::White ? 1.0f : 0.0f;
+        default:
+            return 0.5f;
+    }
+}
+
+[[nodiscard]] Batch make_batch(std::vector<TrainingEntry>::const_iterator first,
+                               std::vector<TrainingEntry>::const_iterator last) {
+    Batch batch;
+    const auto n = static_cast<std::size_t>(last - first);
+    batch.us.reserve(n);
+    batch.them.reserve(n);
+    batch.gaps.reserve(n);
+    batch.scores.reserve(n);
+    batch.results.reserve(n);
+
+    for (auto it = first; it != last; ++it) {
+        batch.us.push_back(it->pos.get_us().compressed());
+        batch.them.push_back(it->pos.get_them().compressed());
+        batch.gaps.push_back(it->pos.get_gaps().compressed());
+        batch.scores.push_back(it->score);
+        batch.results.push_back(relative_result(*it));
+    }
+
+    return batch;
+}
+
+}  // namespace
+
+Writer::Writer(std::ostream &os, const std::size_t chunk_size) : os_{os}, chunk_size_{chunk_size} {
+}
+
+Writer::~Writer() {
+    flush();
+}
+
+void Writer::add(const TrainingEntry &added) {
+    // Chains and their checksums go by the hash, which positions built from
+    // bitboards don't have until it's recalculated
+    auto entry = added;
+    entry.pos.recalculate_hash();
+
+    if (!in_chain_ || !continues_chain(entry)) {
+        end_chain();
+        chain_start_ = entry.pos;
+        in_chain_ = true;
+        num_chains_++;
+    }
+
+    put_bytes(chain_, encode_move(entry.move), 2);
+    put_varint(chain_, zigzag(entry.score));
+    chain_length_++;
+    num_entries_++;
+    last_ = entry;
+}
+
+void Writer::flush() {
+    end_chain();
+
+    if (!chunk_.empty()) {
+        std::vector<std::uint8_t> header(std::begin(magic), std::end(magic));
+        put_bytes(header, chunk_.size(), 4);
+        os_.write(reinterpret_cast<const char *>(header.data()), header.size());
+        os_.write(reinterpret_cast<const char *>(chunk_.data()), chunk_.size());
+        chunk_.clear();
+    }
+
+    os_.flush();
+}
+
+[[nodiscard]] bool Writer::continues_chain(const TrainingEntry &entry) const noexcept {
+    const auto &prev = last_;
+
+    if (prev.move == Move::nomove() || prev.result != entry.result) {
+        return false;
+    }
+
+    if (!prev.pos.is_pseudolegal_move(prev.move)) {
+        return false;
+    }
+
+    // Board and turn
+    if (prev.pos.predict_hash(prev.move) != entry.pos.get_hash()) {
+        return false;
+    }
+
+    // Counters, these follow the rules in Position::makemove()
+    const bool resets = prev.move != Move::nullmove() && prev.move.is_single();
+    const unsigned int halfmoves = resets ? 0 : prev.pos.get_halfmoves() + 1;
+    const unsigned int fullmoves = prev.pos.get_fullmoves() + (prev.pos.get_turn() == Side::White);
+
+    return entry.pos.get_halfmoves() == halfmoves && entry.pos.get_fullmoves() == fullmoves;
+}
+
+void Writer::end_chain() {
+    if (!in_chain_) {
+        return;
+    }
+
+    // Starting position
+    put_bytes(chunk_, chain_start_.get_black().compressed(), 7);
+    put_bytes(chunk_, chain_start_.get_white().compressed(), 7);
+    put_bytes(chunk_, chain_start_.get_gaps().compressed(), 7);
+    put_bytes(chunk_, static_cast<int>(chain_start_.get_turn()) | (static_cast<int>(last_.result) << 1), 1);
+    put_varint(chunk_, chain_start_.get_halfmoves());
+    put_varint(chunk_, chain_start_.get_fullmoves());
+
+    // Moves and scores
+    put_varint(chunk_, chain_length_);
+    chunk_.insert(chunk_.end(), chain_.begin(), chain_.end());
+
+    // Check the replayed chain ends where it should
+    put_bytes(chunk_, last_.pos.get_hash() & 0xFFFFFFFFULL, 4);
+
+    chain_.clear();
+    chain_length_ = 0;
+    in_chain_ = false;
+
+    if (chunk_.size() >= chunk_size_) {
+        flush();
+    }
+}
+
+[[nodiscard]] std::vector<TrainingEntry> decode_chunk(const std::uint8_t *data, const std::size_t size) {
+    std::vector<TrainingEntry> entries;
+    Cursor cursor{data, size};
+
+    while (!cursor.done()) {
+        const auto black = cursor.bytes(7);
+        const auto white = cursor.bytes(7);
+        const auto gaps = cursor.bytes(7);
+        const auto flags = cursor.bytes(1);
+        const auto halfmoves = cursor.varint();
+        const auto fullmoves = cursor.varint();
+        const auto length = cursor.varint();
+
+        if (((black | white | gaps) >> 49) || (black & white) || (black & gaps) || (white & gaps) || flags > 7 ||
+            length == 0) {
+            throw std::runtime_error("binpack: invalid chain header");
+        }
+
+        const auto turn = static_cast<Side>(flags & 1);
+        const auto result = static_cast<Result>(flags >> 1);
+        auto pos = Position{Bitboard::from_compressed(black),
+                            Bitboard::from_compressed(white),
+                            Bitboard::from_compressed(gaps),
+                            static_cast<unsigned int>(halfmoves),
+                            static_cast<unsigned int>(fullmoves),
+                            turn};
+        pos.recalculate_hash();
+
+        for (std::uint64_t i = 0; i < length; ++i) {
+            const auto move = decode_move(cursor.bytes(2));
+            const auto score = unzigzag(cursor.varint());
+            entries.push_back(TrainingEntry{pos, move, static_cast<std::int16_t>(score), result});
+
+            if (i + 1 < length) {
+                if (move == Move::nomove() || !pos.is_pseudolegal_move(move)) {
+                    throw std::runtime_error("binpack: illegal move in chain");
+                }
+                pos.makemove(move);
+            }
+        }
+
+        if (cursor.bytes(4) != (pos.get_hash() & 0xFFFFFFFFULL)) {
+            throw std::runtime_error("binpack: chain checksum mismatch");
+        }
+    }
+
+    return entries;
+}
+
+[[nodiscard]] bool Reader::next(TrainingEntry &entry) {
+    while (idx_ >= entries_.size()) {
+        char header[8];
+        if (!is_.read(header, 8)) {
+            if (is_.gcount() == 0) {
+                return false;
+            }
+            throw std::runtime_error("binpack: truncated chunk header");
+        }
+        if (!std::equal(std::begin(magic), std::end(magic), header)) {
+            throw std::runtime_error("binpack: invalid chunk magic");
+        }
+
+        std::uint32_t size = 0;
+        for (int i = 0; i < 4; ++i) {
+            size |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(header[4 + i])) << (8 * i);
+        }
+
+        std::vector<std::uint8_t> buffer(size);
+        if (!is_.read(reinterpret_cast<char *>(buffer.data()), size)) {
+            throw std::runtime_error("binpack: truncated chunk");
+        }
+
+        entries_ = decode_chunk(buffer.data(), buffer.size());
+        idx_ = 0;
+    }
+
+    entry = entries_[idx_];
+    idx_++;
+    return true;
+}
+
+BatchLoader::BatchLoader(const std::string &path, const LoaderOptions &options) : path_{path}, options_{options} {
+    options_.batch_size = std::max<std::size_t>(1, options_.batch_size);
+    options_.threads = std::max(1, options_.threads);
+
+    std::ifstream fs(path_, std::ios::binary);
+    if (!fs.is_open()) {
+        throw std::runtime_error("binpack: could not open " + path_);
+    }
+
+    // Find chunks
+    char header[8];
+    while (fs.read(header, 8)) {
+        if (!std::equal(std::begin(magic), std::end(magic), header)) {
+            throw std::runtime_error("binpack: invalid chunk magic");
+        }
+
+        Chunk chunk;
+        chunk.offset = static_cast<std::uint64_t>(fs.tellg());
+        for (int i = 0; i < 4; ++i) {
+            chunk.size |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(header[4 + i])) << (8 * i);
+        }
+        chunks_.push_back(chunk);
+        fs.seekg(chunk.size, std::ios::cur);
+    }
+
+    if (options_.shuffle) {
+        std::mt19937_64 rng(options_.seed);
+        std::shuffle(chunks_.begin(), chunks_.end(), rng);
+    }
+
+    max_queued_ = 2 * options_.threads + 2;
+    running_ = options_.threads;
+    for (int i = 0; i < options_.threads; ++i) {
+        threads_.emplace_back(&BatchLoader::worker, this, i);
+    }
+}
+
+BatchLoader::~BatchLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_full_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+[[nodiscard]] std::optional<Batch> BatchLoader::next() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_empty_.wait(lock, [this] { return !queue_.empty() || running_ == 0 || error_; });
+
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+
+    if (queue_.empty()) {
+        return std::nullopt;
+    }
+
+    auto batch = std::move(queue_.front());
+    queue_.pop_front();
+    cv_full_.notify_one();
+    return batch;
+}
+
+void BatchLoader::push(Batch &&batch) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_full_.wait(lock, [this] { return stop_ || queue_.size() < max_queued_; });
+    if (stop_) {
+        return;
+    }
+    queue_.push_back(std::move(batch));
+    cv_empty_.notify_one();
+}
+
+void BatchLoader::worker(const int id) {
+    try {
+        std::ifstream fs(path_, std::ios::binary);
+        std::mt19937_64 rng(options_.seed + id + 1);
+        std::vector<std::uint8_t> buffer;
+        std::vector<TrainingEntry> pool;
+
+        const auto emit = [&](const bool last) {
+            if (options_.shuffle) {
+                std::shuffle(pool.begin(), pool.end(), rng);
+            }
+
+            std::size_t idx = 0;
+            while (!stop_ && pool.size() - idx >= options_.batch_size) {
+                push(make_batch(pool.begin() + idx, pool.begin() + idx + options_.batch_size));
+                idx += options_.batch_size;
+            }
+            if (!stop_ && last && idx < pool.size()) {
+                push(make_batch(pool.begin() + idx, pool.end()));
+                idx = pool.size();
+            }
+            pool.erase(pool.begin(), pool.begin() + idx);
+        };
+
+        while (!stop_) {
+            const auto idx = next_chunk_++;
+            if (idx >= chunks_.size()) {
+                break;
+            }
+
+            const auto &chunk = chunks_[idx];
+            buffer.resize(chunk.size);
+            fs.seekg(chunk.offset);
+            if (!fs.read(reinterpret_cast<char *>(buffer.data()), chunk.size)) {
+                throw std::runtime_error("binpack: truncated chunk");
+            }
+
+            const auto entries = decode_chunk(buffer.data(), buffer.size());
+            pool.insert(pool.end(), entries.begin(), entries.end());
+
+            // Only shuffle once entries from several chunks are mixed together
+            if (pool.size() >= std::max(options_.shuffle_buffer, options_.batch_size)) {
+                emit(false);
+            }
+        }
+
+        emit(true);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+        stop_ = true;
+        cv_full_.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_--;
+    cv_empty_.notify_all();
+}
+
+}  // namespace libataxx::binpack
@@ -0,0 +1,156 @@
+#include "libataxx/board.hpp"
+#include "libataxx/lookup.hpp"
+#include "libataxx/zobrist.hpp"
+
+namespace libataxx {
+
+Board::Board(const Bitboard &gaps) noexcept : gaps_{gaps & Bitboard(Bitmask::All)} {
+    squares_ = Bitboard(Bitmask::All) ^ gaps_;
+
+    for (const auto &sq : squares_) {
+        singles_[static_cast<int>(sq)] = lut::get_singles(sq) & squares_;
+        doubles_[static_cast<int>(sq)] = lut::get_doubles(sq) & squares_;
+    }
+
+    // Flood fill each region from its lowest square
+    auto left = squares_;
+    while (left) {
+        Bitboard region{Square{left.lsbll()}};
+        Bitboard frontier = region;
+        while (frontier) {
+            Bitboard next;
+            for (const auto &sq : frontier) {
+                next |= singles(sq) | doubles(sq);
+            }
+            frontier = next & ~region;
+            region |= frontier;
+        }
+
+        regions_[num_regions_++] = region;
+        left &= ~region;
+        for (const auto &sq : region) {
+            region_[static_cast<int>(sq)] = region;
+        }
+    }
+
+    for (const auto t : transforms) {
+        if (transform(gaps_, t) == gaps_) {
+            symmetries_[num_symmetries_++] = t;
+            symmetry_mask_ |= 1U << static_cast<int>(t);
+        }
+    }
+
+    for (const auto &sq : gaps_) {
+        gaps_hash_ ^= zobrist::get_key(Piece::Gap, sq);
+    }
+}
+
+[[nodiscard]] int Board::legal_moves(const Position &pos, Move *movelist) const noexcept {
+    assert(movelist);
+
+    if (pos.is_gameover()) {
+        return 0;
+    }
+
+    const auto empty = get_empty(pos);
+    int num_moves = 0;
+
+    // Single moves
+    for (const auto &to : pos.get_us().singles() & empty) {
+        movelist[num_moves] = Move(to);
+        num_moves++;
+    }
+
+    // Double moves
+    for (const auto &from : pos.get_us()) {
+        for (const auto &to : doubles(from) & empty) {
+            movelist[num_moves] = Move(from, to);
+            num_moves++;
+        }
+    }
+
+    if (num_moves == 0) {
+        movelist[0] = Move::nullmove();
+        num_moves++;
+    }
+
+    return num_moves;
+}
+
+[[nodiscard]] int Board::count_legal_moves(const Position &pos) const noexcept {
+    if (pos.is_gameover()) {
+        return 0;
+    }
+
+    const auto empty = get_empty(pos);
+    int num_moves = (pos.get_us().singles() & empty).count();
+    for (const auto &from : pos.get_us()) {
+        num_moves += (doubles(from) & empty).count();
+    }
+
+    return num_moves == 0 ? 1 : num_moves;
+}
+
+// Stones reach every empty square of their region, the path there can go
+// through other stones because every stone can move on from where it is
+[[nodiscard]] Bitboard Board::get_reachable(const Position &pos) const noexcept {
+    const auto both = pos.get_both();
+    auto reachable = both;
+    for (const auto &region : regions()) {
+        if (region & both) {
+            reachable |= region;
+        }
+    }
+    return reachable;
+}
+
+// Only regions shared with the other side need filling in
+[[nodiscard]] Bitboard Board::get_reachable(const Position &pos, const Side s) const noexcept {
+    const auto us = pos.get_side(s);
+    if (num_regions_ == 1) {
+        return pos.get_reachable(us, get_empty(pos));
+    }
+
+    const auto them = pos.get_side(!s);
+    auto reachable = us;
+    Bitboard fill_from;
+    Bitboard fill_in;
+
+    for (const auto &region : regions()) {
+        if (!(region & us)) {
+            continue;
+        }
+        if (region & them) {
+            fill_from |= region & us;
+            fill_in |= region & ~pos.get_both();
+        } else {
+            reachable |= region;
+        }
+    }
+
+    if (fill_from) {
+        reachable |= pos.get_reachable(fill_from, fill_in);
+    }
+    return reachable;
+}
+
+[[nodiscard]] std::uint64_t Board::calculate_hash(const Position &pos) const noexcept {
+    assert(matches(pos));
+    std::uint64_t key = gaps_hash_;
+
+    if (pos.get_turn() == Side::Black) {
+        key ^= zobrist::turn_key();
+    }
+
+    for (const auto &sq : pos.get_black()) {
+        key ^= zobrist::get_key(Piece::Black, sq);
+    }
+
+    for (const auto &sq : pos.get_white()) {
+        key ^= zobrist::get_key(Piece::White, sq);
+    }
+
+    return key;
+}
+
+}  // namespace libataxx
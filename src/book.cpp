@@ -0,0 +1,273 @@
+#include "libataxx/book.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include "libataxx/binpack.hpp"
+#include "libataxx/pgn.hpp"
+#include "libataxx/symmetry.hpp"
+
+namespace libataxx::book {
+
+namespace {
+
+constexpr char magic[8] = {'A', 'T', 'X', 'B', 'O', 'O', 'K', '1'};
+constexpr std::uint32_t flag_symmetric = 1;
+// Keys only use the transforms that keep the gaps in place
+constexpr std::uint32_t flag_gap_symmetries = 2;
+constexpr std::size_t header_size = 24;
+
+// Keys are hashes and close to uniform, so a few interpolation steps get
+// within a handful of entries before finishing with a binary search
+constexpr int max_interpolation_steps = 8;
+
+[[nodiscard]] std::uint16_t encode_move(const Move &move) noexcept {
+    return static_cast<std::uint16_t>(49 * move.from().index() + move.to().index());
+}
+
+[[nodiscard]] Move decode_move(const std::uint16_t n) noexcept {
+    const auto from = Square{(n / 49) % 7, (n / 49) / 7};
+    const auto to = Square{(n % 49) % 7, (n % 49) / 7};
+    return from == to ? Move(to) : Move(from, to);
+}
+
+[[nodiscard]] bool entry_order(const Entry &a, const Entry &b) noexcept {
+    return a.key < b.key || (a.key == b.key && a.move < b.move);
+}
+
+void put_bytes(std::ostream &os, std::uint64_t n, const int bytes) {
+    char buffer[8];
+    for (int i = 0; i < bytes; ++i) {
+        buffer[i] = static_cast<char>(n & 0xFF);
+        n >>= 8;
+    }
+    os.write(buffer, bytes);
+}
+
+}  // namespace
+
+void Builder::add(const Position &pos, const Move &move, const Result result) {
+    if (result == Result::None || move == Move::nomove() || move == Move::nullmove()) {
+        return;
+    }
+
+    Entry entry;
+    if (options_.symmetric) {
+        const auto [key, t] = canonical(pos);
+        entry.key = key;
+        entry.move = encode_move(transform(move, t));
+    } else {
+        entry.key = pos.get_hash();
+        entry.move = encode_move(move);
+    }
+
+    const bool draw = result == Result::Draw;
+    const bool win = (result == Result::BlackWin && pos.get_turn() == Side::Black) ||
+                     (result == Result::WhiteWin && pos.get_turn() == Side::White);
+    entry.games = 1;
+    entry.wins = win;
+    entry.draws = draw;
+    entries_.push_back(entry);
+
+    // Merge duplicates once the unmerged tail is as big as the merged part
+    if (entries_.size() >= 2 * compacted_ + (1 << 16)) {
+        compact();
+    }
+}
+
+void Builder::add_game(Position pos, const std::vector<Move> &moves, const Result result) {
+    for (std::size_t i = 0; i < moves.size() && static_cast<int>(i) < options_.max_ply; ++i) {
+        if (!pos.is_legal_move(moves[i])) {
+            return;
+        }
+        add(pos, moves[i], result);
+        pos.makemove(moves[i]);
+    }
+}
+
+void Builder::add_pgn(std::istream &is) {
+    while (const auto pgn = pgn::read(is)) {
+        add_game(pgn::start_position(*pgn), pgn->root().mainline(), pgn::get_result(*pgn));
+    }
+}
+
+void Builder::add_binpack(std::istream &is) {
+    binpack::Reader reader{is};
+    binpack::TrainingEntry entry;
+    while (reader.next(entry)) {
+        const auto ply = 2 * (static_cast<int>(entry.pos.get_fullmoves()) - 1) + (entry.pos.get_turn() == Side::White);
+        if (ply < options_.max_ply) {
+            add(entry.pos, entry.move, entry.result);
+        }
+    }
+}
+
+void Builder::compact() {
+    if (compacted_ == entries_.size()) {
+        return;
+    }
+
+    std::sort(entries_.begin(), entries_.end(), entry_order);
+
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        if (n > 0 && entries_[n - 1].key == entries_[i].key && entries_[n - 1].move == entries_[i].move) {
+            entries_[n - 1].games += entries_[i].games;
+            entries_[n - 1].wins += entries_[i].wins;
+            entries_[n - 1].draws += entries_[i].draws;
+        } else {
+            entries_[n++] = entries_[i];
+        }
+    }
+
+    entries_.resize(n);
+    compacted_ = n;
+}
+
+void Builder::write(std::ostream &os, const std::uint32_t min_games) {
+    compact();
+
+    const auto count = static_cast<std::uint64_t>(
+        std::count_if(entries_.begin(), entries_.end(), [min_games](const Entry &e) { return e.games >= min_games; }));
+
+    os.write(magic, sizeof(magic));
+    put_bytes(os, options_.symmetric ? flag_symmetric | flag_gap_symmetries : 0, 4);
+    put_bytes(os, 0, 4);
+    put_bytes(os, count, 8);
+
+    for (const auto &entry : entries_) {
+        if (entry.games >= min_games) {
+            os.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        }
+    }
+
+    os.flush();
+}
+
+Book::Book(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("book: could not open " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < header_size) {
+        ::close(fd);
+        throw std::runtime_error("book: invalid file " + path);
+    }
+
+    bytes_ = static_cast<std::size_t>(st.st_size);
+    data_ = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("book: could not map " + path);
+    }
+
+    const auto *bytes = static_cast<const char *>(data_);
+    std::uint32_t flags = 0;
+    std::uint64_t count = 0;
+    std::memcpy(&flags, bytes + 8, sizeof(flags));
+    std::memcpy(&count, bytes + 16, sizeof(count));
+
+    if (std::memcmp(bytes, magic, sizeof(magic)) != 0 || count != (bytes_ - header_size) / sizeof(Entry) ||
+        (bytes_ - header_size) % sizeof(Entry) != 0) {
+        ::munmap(data_, bytes_);
+        data_ = nullptr;
+        throw std::runtime_error("book: invalid file " + path);
+    }
+
+    entries_ = reinterpret_cast<const Entry *>(bytes + header_size);
+    size_ = count;
+    symmetric_ = flags & flag_symmetric;
+    all_symmetries_ = symmetric_ && !(flags & flag_gap_symmetries);
+
+    ::madvise(data_, bytes_, MADV_RANDOM);
+}
+
+Book::~Book() {
+    if (data_) {
+        ::munmap(data_, bytes_);
+    }
+}
+
+[[nodiscard]] const Entry *Book::lower_bound(const std::uint64_t key) const noexcept {
+    // Everything before lo is smaller than the key, everything from hi on isn't
+    std::size_t lo = 0;
+    std::size_t hi = size_;
+
+    for (int i = 0; i < max_interpolation_steps && hi - lo > 16; ++i) {
+        const auto lo_key = entries_[lo].key;
+        const auto hi_key = entries_[hi - 1].key;
+        if (key <= lo_key) {
+            return entries_ + lo;
+        }
+        if (key > hi_key) {
+            return entries_ + hi;
+        }
+
+        const auto offset = static_cast<unsigned __int128>(key - lo_key) * (hi - 1 - lo) / (hi_key - lo_key);
+        const auto mid = lo + static_cast<std::size_t>(offset);
+        if (entries_[mid].key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return std::lower_bound(
+        entries_ + lo, entries_ + hi, key, [](const Entry &entry, const std::uint64_t k) { return entry.key < k; });
+}
+
+[[nodiscard]] std::vector<BookMove> Book::probe(const Position &pos, const std::uint8_t symmetries) const {
+    auto key = pos.get_hash();
+    auto t = Transform::None;
+    if (symmetric_) {
+        std::tie(key, t) = canonical(pos, all_symmetries_ ? all_symmetries : symmetries);
+    }
+
+    std::vector<BookMove> moves;
+    for (auto entry = lower_bound(key); entry != entries_ + size_ && entry->key == key; ++entry) {
+        const auto move = transform(decode_move(entry->move), inverse(t));
+
+        // Guard against hash collisions
+        if (!pos.is_legal_move(move)) {
+            continue;
+        }
+
+        moves.push_back({move, entry->games, entry->wins, entry->draws});
+    }
+
+    std::stable_sort(
+        moves.begin(), moves.end(), [](const BookMove &a, const BookMove &b) { return a.games > b.games; });
+
+    return moves;
+}
+
+[[nodiscard]] Move Book::pick(const Position &pos, const std::uint64_t random) const {
+    const auto moves = probe(pos);
+
+    std::uint64_t total = 0;
+    for (const auto &move : moves) {
+        total += move.games;
+    }
+    if (total == 0) {
+        return Move::nomove();
+    }
+
+    auto r = random % total;
+    for (const auto &move : moves) {
+        if (r < move.games) {
+            return move.move;
+        }
+        r -= move.games;
+    }
+
+    return Move::nomove();
+}
+
+}  // namespace libataxx::book
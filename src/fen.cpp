@@ -0,0 +1,87 @@
+#include "libataxx/fen.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace libataxx::fen {
+
+namespace {
+
+// Not worth starting threads for small buffers
+constexpr std::size_t min_lines_per_thread = 4096;
+
+[[nodiscard]] std::vector<std::string_view> split_lines(const std::string_view buffer) {
+    std::vector<std::string_view> lines;
+    std::size_t start = 0;
+    while (start < buffer.size()) {
+        auto end = buffer.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = buffer.size();
+        }
+
+        const auto line = buffer.substr(start, end - start);
+        if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+            lines.push_back(line);
+        }
+
+        start = end + 1;
+    }
+    return lines;
+}
+
+void parse_range(const std::vector<std::string_view> &lines,
+                 std::vector<std::optional<Position>> &results,
+                 const std::size_t first,
+                 const std::size_t last) noexcept {
+    for (std::size_t i = first; i < last; ++i) {
+        results[i] = Position::from_fen(lines[i]);
+    }
+}
+
+}  // namespace
+
+[[nodiscard]] std::vector<std::optional<Position>> parse_lines(const std::string_view buffer, unsigned int threads) {
+    const auto lines = split_lines(buffer);
+    std::vector<std::optional<Position>> results(lines.size());
+
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    threads = std::min<std::size_t>(threads, std::max<std::size_t>(1, lines.size() / min_lines_per_thread));
+
+    if (threads <= 1) {
+        parse_range(lines, results, 0, lines.size());
+        return results;
+    }
+
+    // Each thread takes a contiguous block of lines
+    std::vector<std::thread> workers;
+    const auto block = (lines.size() + threads - 1) / threads;
+    for (std::size_t first = 0; first < lines.size(); first += block) {
+        const auto last = std::min(lines.size(), first + block);
+        workers.emplace_back(parse_range, std::cref(lines), std::ref(results), first, last);
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    return results;
+}
+
+void write_lines(const std::span<const Position> positions, std::string &out) {
+    // Batches of FENs go through a buffer on the stack so the string is only
+    // touched once per batch
+    constexpr std::size_t batch_size = 64;
+    char buffer[batch_size * (Position::fen_buffer_size + 1)];
+
+    for (std::size_t first = 0; first < positions.size(); first += batch_size) {
+        const auto last = std::min(positions.size(), first + batch_size);
+        auto ptr = buffer;
+        for (std::size_t i = first; i < last; ++i) {
+            ptr = positions[i].write_fen(ptr);
+            *ptr++ = '\n';
+        }
+        out.append(buffer, ptr);
+    }
+}
+
+}  // namespace libataxx::fen
@@ -1,67 +1,87 @@
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include "libataxx/bitboard.hpp"
 #include "libataxx/position.hpp"
 
 namespace libataxx {
 
-[[nodiscard]] std::string Position::get_fen() const noexcept {
-    std::string fen;
+namespace {
 
-    // Board
-    for (int y = 6; y >= 0; --y) {
+// Every rank indexed by two 7 bit planes, (black | gaps) and (white | gaps)
+// Each entry holds up to 7 characters with the length in the top byte
+constexpr auto rank_table = []() {
+    std::array<std::uint64_t, 1 << 14> table{};
+    for (std::size_t idx = 0; idx < table.size(); ++idx) {
+        std::uint64_t chars = 0;
+        int length = 0;
         int empty = 0;
 
-        for (int x = 0; x < 7; ++x) {
-            const auto f = File{x};
-            const auto r = Rank{y};
-            const auto sq = Square{f, r};
-            const auto bb = Bitboard{sq};
+        const auto push = [&](const char c) {
+            chars |= static_cast<std::uint64_t>(static_cast<unsigned char>(c)) << (8 * length);
+            length++;
+        };
 
-            if (bb & get_black()) {
-                if (empty > 0) {
-                    fen += std::to_string(empty);
-                    empty = 0;
-                }
-                fen += "x";
-            } else if (bb & get_white()) {
-                if (empty > 0) {
-                    fen += std::to_string(empty);
-                    empty = 0;
-                }
-                fen += "o";
-            } else if (bb & get_gaps()) {
-                if (empty > 0) {
-                    fen += std::to_string(empty);
-                    empty = 0;
-                }
-                fen += "-";
-            } else {
-                empty += 1;
+        for (int x = 0; x < 7; ++x) {
+            const bool a = (idx >> x) & 1;
+            const bool b = (idx >> (x + 7)) & 1;
+            if (!a && !b) {
+                empty++;
+                continue;
             }
+            if (empty > 0) {
+                push(static_cast<char>('0' + empty));
+                empty = 0;
+            }
+            push(a && b ? '-' : a ? 'x' : 'o');
         }
-
         if (empty > 0) {
-            fen += std::to_string(empty);
-        }
-        if (y > 0) {
-            fen += "/";
+            push(static_cast<char>('0' + empty));
         }
+
+        table[idx] = chars | (static_cast<std::uint64_t>(length) << 56);
     }
+    return table;
+}();
 
-    // Turn
-    if (get_turn() == Side::Black) {
-        fen += " x";
-    } else {
-        fen += " o";
+}  // namespace
+
+char *Position::write_fen(char *out) const noexcept {
+    const auto a = (get_black() | get_gaps()).data();
+    const auto b = (get_white() | get_gaps()).data();
+
+    // Board
+    // The table entries are copied whole and the length decides how far to
+    // move on, so every rank is a single 8 byte store
+    for (int y = 6; y >= 0; --y) {
+        const auto idx = ((a >> (8 * y)) & 0x7f) | (((b >> (8 * y)) & 0x7f) << 7);
+        const auto entry = rank_table[idx];
+        std::memcpy(out, &entry, sizeof(entry));
+        out += entry >> 56;
+        *out++ = '/';
     }
+    out--;
+
+    // Turn
+    *out++ = ' ';
+    *out++ = get_turn() == Side::Black ? 'x' : 'o';
 
     // Halfmove clock
-    fen += " " + std::to_string(halfmoves_);
+    *out++ = ' ';
+    out = std::to_chars(out, out + 10, halfmoves_).ptr;
 
     // Fullmove number
-    fen += " " + std::to_string(fullmoves_);
+    *out++ = ' ';
+    out = std::to_chars(out, out + 10, fullmoves_).ptr;
+
+    return out;
+}
 
-    return fen;
+[[nodiscard]] std::string Position::get_fen() const noexcept {
+    char buffer[fen_buffer_size];
+    return std::string(buffer, write_fen(buffer));
 }
 
 }  // namespace libataxx
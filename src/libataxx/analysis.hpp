@@ -0,0 +1,72 @@
+#ifndef LIBATAXX_ANALYSIS_HPP
+#define LIBATAXX_ANALYSIS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "move.hpp"
+#include "pgn.hpp"
+#include "position.hpp"
+#include "search.hpp"
+
+namespace libataxx::analysis {
+
+struct Options {
+    // Set limits.multipv for more than the best move
+    search::Limits limits;
+    int threads = 1;
+    std::size_t hash_mb = 16;
+    // Clears the table and histories before every position, so each result
+    // doesn't depend on which thread searched what before it
+    bool clear = false;
+};
+
+// Called with the index of the position, its result and the time searched
+using ResultHandler =
+    std::function<void(const std::size_t index, const search::Result &result, const std::chrono::milliseconds time)>;
+
+// Searches positions[first] onwards, spread over the threads with a search
+// and table for each thread
+// The handler is called once per position in index order, from whichever
+// thread finished the position it was waiting on, never two at once
+// Exceptions thrown by the handler stop the workers and are rethrown
+void analyse(const std::vector<Position> &positions,
+             const Options &options,
+             const ResultHandler &handler,
+             const std::size_t first = 0);
+
+// Results are in the same order as the positions
+[[nodiscard]] std::vector<search::Result> analyse(const std::vector<Position> &positions, const Options &options);
+
+// How far a batch got, the positions finished and the size of the output
+// that holds their results
+struct Checkpoint {
+    std::size_t positions = 0;
+    std::uint64_t bytes = 0;
+};
+
+// An empty checkpoint if the file doesn't exist
+[[nodiscard]] Checkpoint read_checkpoint(const std::string &path);
+
+// Written to a temporary file and renamed over the old one, so a crash leaves
+// either the old checkpoint or the new one
+void write_checkpoint(const std::string &path, const Checkpoint &checkpoint);
+
+// "+1.20/8" from the side to move's point of view, "#3" and "#-3" for mates
+[[nodiscard]] std::string format_score(const int score, const int depth);
+
+// The played move's score if it's one of the lines, otherwise the best move
+// and its score, then every line when there's more than one
+// "-0.40/7 best f2 +1.00/7 [f2 +1.00/7, g3 +0.60/7, b6 -0.40/7]"
+[[nodiscard]] std::string format_comment(const search::Result &result, const Move &played);
+
+// Comments every mainline move with the analysis of the position before it
+// Stops at the first illegal move
+void annotate(pgn::PGN &game, const Options &options);
+
+}  // namespace libataxx::analysis
+
+#endif
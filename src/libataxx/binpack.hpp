@@ -0,0 +1,164 @@
+#ifndef LIBATAXX_BINPACK_HPP
+#define LIBATAXX_BINPACK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "move.hpp"
+#include "position.hpp"
+
+namespace libataxx::binpack {
+
+// File layout:
+// - The file is a sequence of chunks: "BINP", u32 payload size, payload
+// - A payload is a sequence of chains, a chain never crosses a chunk boundary
+// - A chain stores one full position followed by the moves that link it to
+//   the positions after it, so consecutive positions from a game cost a few
+//   bytes each instead of three bitboards
+
+constexpr std::size_t default_chunk_size = 1 << 20;
+
+struct TrainingEntry {
+    Position pos;
+    Move move;
+    // Relative to the side to move
+    std::int16_t score = 0;
+    Result result = Result::None;
+};
+
+class Writer {
+   public:
+    explicit Writer(std::ostream &os, const std::size_t chunk_size = default_chunk_size);
+
+    ~Writer();
+
+    Writer(const Writer &) = delete;
+
+    Writer &operator=(const Writer &) = delete;
+
+    // Entries continue the current chain whenever the previous entry's move
+    // leads to this entry's position
+    void add(const TrainingEntry &entry);
+
+    void flush();
+
+    [[nodiscard]] std::uint64_t num_entries() const noexcept {
+        return num_entries_;
+    }
+
+    [[nodiscard]] std::uint64_t num_chains() const noexcept {
+        return num_chains_;
+    }
+
+   private:
+    [[nodiscard]] bool continues_chain(const TrainingEntry &entry) const noexcept;
+
+    void end_chain();
+
+    std::ostream &os_;
+    std::size_t chunk_size_;
+    std::vector<std::uint8_t> chunk_;
+    std::vector<std::uint8_t> chain_;
+    std::uint64_t chain_length_ = 0;
+    Position chain_start_;
+    TrainingEntry last_;
+    bool in_chain_ = false;
+    std::uint64_t num_entries_ = 0;
+    std::uint64_t num_chains_ = 0;
+};
+
+// Throws std::runtime_error on malformed or inconsistent data
+[[nodiscard]] std::vector<TrainingEntry> decode_chunk(const std::uint8_t *data, const std::size_t size);
+
+class Reader {
+   public:
+    explicit Reader(std::istream &is) : is_{is} {
+    }
+
+    // Throws std::runtime_error on malformed or inconsistent data
+    [[nodiscard]] bool next(TrainingEntry &entry);
+
+   private:
+    std::istream &is_;
+    std::vector<TrainingEntry> entries_;
+    std::size_t idx_ = 0;
+};
+
+// Planes are compressed to 49 bits, see Bitboard::compressed()
+struct Batch {
+    [[nodiscard]] std::size_t size() const noexcept {
+        return scores.size();
+    }
+
+    std::vector<std::uint64_t> us;
+    std::vector<std::uint64_t> them;
+    std::vector<std::uint64_t> gaps;
+    std::vector<std::int16_t> scores;
+    // 1 win, 0.5 draw or unknown, 0 loss -- relative to the side to move
+    std::vector<float> results;
+};
+
+struct LoaderOptions {
+    std::size_t batch_size = 1024;
+    int threads = 1;
+    bool shuffle = true;
+    // Entries pooled across chunks before being shuffled into batches
+    std::size_t shuffle_buffer = 1 << 16;
+    std::uint64_t seed = 0;
+};
+
+class BatchLoader {
+   public:
+    BatchLoader(const std::string &path, const LoaderOptions &options);
+
+    ~BatchLoader();
+
+    BatchLoader(const BatchLoader &) = delete;
+
+    BatchLoader &operator=(const BatchLoader &) = delete;
+
+    // Blocks until a batch is ready, returns nothing once the file is exhausted
+    // The last batch may be smaller than the batch size
+    [[nodiscard]] std::optional<Batch> next();
+
+    [[nodiscard]] std::size_t num_chunks() const noexcept {
+        return chunks_.size();
+    }
+
+   private:
+    struct Chunk {
+        std::uint64_t offset = 0;
+        std::uint32_t size = 0;
+    };
+
+    void worker(const int id);
+
+    void push(Batch &&batch);
+
+    std::string path_;
+    LoaderOptions options_;
+    std::vector<Chunk> chunks_;
+    std::atomic<std::size_t> next_chunk_ = 0;
+    std::atomic<bool> stop_ = false;
+    std::mutex mtx_;
+    std::condition_variable cv_full_;
+    std::condition_variable cv_empty_;
+    std::deque<Batch> queue_;
+    std::size_t max_queued_ = 0;
+    int running_ = 0;
+    std::exception_ptr error_;
+    std::vector<std::thread> threads_;
+};
+
+}  // namespace libataxx::binpack
+
+#endif
@@ -259,6 +259,19 @@ class Bitboard {
         return flip_vertical().flip_diagA1G7();
     }
 
+    // The 49 squares packed into the low 49 bits, ordered by Square::index()
+    [[nodiscard]] constexpr std::uint64_t compressed() const noexcept {
+        return (data_ & 0x7fULL) | ((data_ >> 1) & 0x3f80ULL) | ((data_ >> 2) & 0x1fc000ULL) |
+               ((data_ >> 3) & 0xfe00000ULL) | ((data_ >> 4) & 0x7f0000000ULL) | ((data_ >> 5) & 0x3f800000000ULL) |
+               ((data_ >> 6) & 0x1fc0000000000ULL);
+    }
+
+    [[nodiscard]] static constexpr Bitboard from_compressed(const std::uint64_t bits) noexcept {
+        return Bitboard{(bits & 0x7fULL) | ((bits & 0x3f80ULL) << 1) | ((bits & 0x1fc000ULL) << 2) |
+                        ((bits & 0xfe00000ULL) << 3) | ((bits & 0x7f0000000ULL) << 4) |
+                        ((bits & 0x3f800000000ULL) << 5) | ((bits & 0x1fc0000000000ULL) << 6)};
+    }
+
    private:
     std::uint64_t data_ = 0;
 };
@@ -354,6 +367,11 @@ static_assert(!Bitboard(Bitmask::All).is_empty());
 static_assert(!Bitboard(Bitmask::Empty).is_occupied());
 static_assert(Bitboard(0x1ULL).is_occupied());
 static_assert(Bitboard(Bitmask::All).is_occupied());
+static_assert(Bitboard(Bitmask::All).compressed() == 0x1ffffffffffffULL);
+static_assert(Bitboard{SquareIndex::G7}.compressed() == 1ULL << 48);
+static_assert(Bitboard{SquareIndex::A2}.compressed() == 1ULL << 7);
+static_assert(Bitboard::from_compressed(0x1ffffffffffffULL) == Bitboard(Bitmask::All));
+static_assert(Bitboard::from_compressed(Bitboard(Bitmask::Edge).compressed()) == Bitboard(Bitmask::Edge));
 
 }  // namespace libataxx
 
@@ -0,0 +1,112 @@
+#ifndef LIBATAXX_BOARD_HPP
+#define LIBATAXX_BOARD_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include "bitboard.hpp"
+#include "move.hpp"
+#include "position.hpp"
+#include "square.hpp"
+#include "symmetry.hpp"
+
+namespace libataxx {
+
+// Everything that follows from a gap layout, which never changes during a game
+// Build one per game and pass it positions with the same gaps
+// - Single and double move tables with the gaps taken out
+// - Regions, the sets of squares stones can move between, stones in
+//   different regions never meet
+// - The transforms that map the gaps onto themselves
+// - The gaps' part of the hash
+class Board {
+   public:
+    [[nodiscard]] explicit Board(const Bitboard &gaps = Bitboard{}) noexcept;
+
+    [[nodiscard]] explicit Board(const Position &pos) noexcept : Board(pos.get_gaps()) {
+    }
+
+    [[nodiscard]] constexpr Bitboard gaps() const noexcept {
+        return gaps_;
+    }
+
+    // Every square that isn't a gap
+    [[nodiscard]] constexpr Bitboard squares() const noexcept {
+        return squares_;
+    }
+
+    [[nodiscard]] constexpr bool matches(const Position &pos) const noexcept {
+        return pos.get_gaps() == gaps_;
+    }
+
+    // Empty for gaps
+    [[nodiscard]] constexpr Bitboard singles(const Square &sq) const noexcept {
+        return singles_[static_cast<int>(sq)];
+    }
+
+    [[nodiscard]] constexpr Bitboard doubles(const Square &sq) const noexcept {
+        return doubles_[static_cast<int>(sq)];
+    }
+
+    [[nodiscard]] std::span<const Bitboard> regions() const noexcept {
+        return {regions_.data(), num_regions_};
+    }
+
+    // Empty for gaps
+    [[nodiscard]] constexpr Bitboard region(const Square &sq) const noexcept {
+        return region_[static_cast<int>(sq)];
+    }
+
+    // Always starts with Transform::None
+    [[nodiscard]] std::span<const Transform> symmetries() const noexcept {
+        return {symmetries_.data(), num_symmetries_};
+    }
+
+    [[nodiscard]] constexpr bool is_symmetry(const Transform t) const noexcept {
+        return has_symmetry(symmetry_mask_, t);
+    }
+
+    // The same as Position::get_symmetries(), for canonical() and friends
+    [[nodiscard]] constexpr std::uint8_t symmetry_mask() const noexcept {
+        return symmetry_mask_;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t gaps_hash() const noexcept {
+        return gaps_hash_;
+    }
+
+    // The same as the position's own functions, in the same order
+
+    [[nodiscard]] int legal_moves(const Position &pos, Move *movelist) const noexcept;
+
+    [[nodiscard]] int count_legal_moves(const Position &pos) const noexcept;
+
+    [[nodiscard]] Bitboard get_reachable(const Position &pos) const noexcept;
+
+    [[nodiscard]] Bitboard get_reachable(const Position &pos, const Side s) const noexcept;
+
+    [[nodiscard]] std::uint64_t calculate_hash(const Position &pos) const noexcept;
+
+   private:
+    [[nodiscard]] constexpr Bitboard get_empty(const Position &pos) const noexcept {
+        assert(matches(pos));
+        return squares_ ^ pos.get_both();
+    }
+
+    Bitboard gaps_;
+    Bitboard squares_;
+    std::array<Bitboard, 64> singles_ = {};
+    std::array<Bitboard, 64> doubles_ = {};
+    std::array<Bitboard, 64> region_ = {};
+    std::array<Bitboard, 49> regions_ = {};
+    std::size_t num_regions_ = 0;
+    std::array<Transform, 8> symmetries_ = {};
+    std::size_t num_symmetries_ = 0;
+    std::uint8_t symmetry_mask_ = 0;
+    std::uint64_t gaps_hash_ = 0;
+};
+
+}  // namespace libataxx
+
+#endif
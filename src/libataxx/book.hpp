@@ -0,0 +1,135 @@
+#ifndef LIBATAXX_BOOK_HPP
+#define LIBATAXX_BOOK_HPP
+
+#include <bit>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "move.hpp"
+#include "position.hpp"
+
+namespace libataxx::book {
+
+// File layout:
+// - Header: "ATXBOOK1", u32 flags, u32 reserved, u64 number of entries
+// - Entries sorted by key then move, 24 bytes each, little endian
+// - Keys are Position::get_hash(), or canonical_hash() for symmetric books
+//   where moves are stored as they'd be played in the canonical position
+// - Symmetric books from before gap symmetries were flagged are keyed over
+//   all 8 transforms, canonical_hash(pos, all_symmetries)
+// The reader maps the file as is, so there is no load step
+
+struct Entry {
+    std::uint64_t key = 0;
+    std::uint16_t move = 0;
+    std::uint16_t reserved = 0;
+    std::uint32_t games = 0;
+    // Relative to the side to move
+    std::uint32_t wins = 0;
+    std::uint32_t draws = 0;
+};
+
+static_assert(sizeof(Entry) == 24);
+static_assert(std::endian::native == std::endian::little);
+
+struct BookMove {
+    [[nodiscard]] std::uint32_t losses() const noexcept {
+        return games - wins - draws;
+    }
+
+    // Expected score for the side to move
+    [[nodiscard]] float score() const noexcept {
+        return games == 0 ? 0.5f : (wins + 0.5f * draws) / games;
+    }
+
+    Move move;
+    std::uint32_t games = 0;
+    std::uint32_t wins = 0;
+    std::uint32_t draws = 0;
+};
+
+struct BuilderOptions {
+    // Key positions by their canonical symmetric hash
+    bool symmetric = false;
+    // Only the first plies of every game are added
+    int max_ply = 40;
+};
+
+class Builder {
+   public:
+    explicit Builder(const BuilderOptions &options = {}) : options_{options} {
+    }
+
+    // Games without a result are skipped
+    void add(const Position &pos, const Move &move, const Result result);
+
+    void add_game(Position pos, const std::vector<Move> &moves, const Result result);
+
+    void add_pgn(std::istream &is);
+
+    // The ply is worked out from the fullmove counter
+    void add_binpack(std::istream &is);
+
+    // Moves played in fewer than min_games games are left out
+    void write(std::ostream &os, const std::uint32_t min_games = 1);
+
+    [[nodiscard]] std::size_t size() {
+        compact();
+        return entries_.size();
+    }
+
+   private:
+    void compact();
+
+    BuilderOptions options_;
+    std::vector<Entry> entries_;
+    std::size_t compacted_ = 0;
+};
+
+class Book {
+   public:
+    // Throws std::runtime_error if the file can't be mapped or isn't a book
+    explicit Book(const std::string &path);
+
+    ~Book();
+
+    Book(const Book &) = delete;
+
+    Book &operator=(const Book &) = delete;
+
+    // Legal book moves for the position, most played first
+    [[nodiscard]] std::vector<BookMove> probe(const Position &pos) const {
+        return probe(pos, pos.get_symmetries());
+    }
+
+    // For when the position's symmetries are already known, such as from a Board
+    [[nodiscard]] std::vector<BookMove> probe(const Position &pos, const std::uint8_t symmetries) const;
+
+    // A book move picked with probability proportional to its games,
+    // Move::nomove() if the position isn't in the book
+    [[nodiscard]] Move pick(const Position &pos, const std::uint64_t random) const;
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool symmetric() const noexcept {
+        return symmetric_;
+    }
+
+   private:
+    [[nodiscard]] const Entry *lower_bound(const std::uint64_t key) const noexcept;
+
+    void *data_ = nullptr;
+    std::size_t bytes_ = 0;
+    const Entry *entries_ = nullptr;
+    std::size_t size_ = 0;
+    bool symmetric_ = false;
+    bool all_symmetries_ = false;
+};
+
+}  // namespace libataxx::book
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef LIBATAXX_FEN_HPP
+#define LIBATAXX_FEN_HPP
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "position.hpp"
+
+namespace libataxx::fen {
+
+// Parses a buffer of newline separated FENs, one result per non-empty line
+// Lines are split across threads, zero threads uses every hardware thread
+[[nodiscard]] std::vector<std::optional<Position>> parse_lines(const std::string_view buffer,
+                                                               unsigned int threads = 0);
+
+// Appends the FEN of every position to the string, one per line
+void write_lines(const std::span<const Position> positions, std::string &out);
+
+}  // namespace libataxx::fen
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef LIBATAXX_HISTORY_HPP
+#define LIBATAXX_HISTORY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include "move.hpp"
+#include "side.hpp"
+
+namespace libataxx::search {
+
+// Every from/to pair on the 7x7 board plus one slot for the nullmove
+constexpr int num_move_indices = 49 * 49 + 1;
+// Every destination plus one slot for the nullmove
+constexpr int num_target_indices = 49 + 1;
+constexpr int num_killers = 2;
+constexpr int max_killer_plies = 128;
+constexpr int max_history = 16384;
+
+[[nodiscard]] constexpr int move_index(const Move &move) noexcept {
+    if (move == Move::nullmove() || move == Move::nomove()) {
+        return num_move_indices - 1;
+    }
+    return 49 * move.from().index() + move.to().index();
+}
+
+[[nodiscard]] constexpr int target_index(const Move &move) noexcept {
+    if (move == Move::nullmove() || move == Move::nomove()) {
+        return num_target_indices - 1;
+    }
+    return move.to().index();
+}
+
+// Pulls the entry towards the bonus, the closer it already is to max_history
+// the smaller the step, so entries saturate instead of overflowing
+constexpr void update_gravity(std::int16_t &entry, const int bonus) noexcept {
+    const int clamped = std::clamp(bonus, -max_history, max_history);
+    entry += clamped - entry * std::abs(clamped) / max_history;
+}
+
+// How often a move has caused a cutoff for the side to move
+class ButterflyHistory {
+   public:
+    [[nodiscard]] int get(const Side side, const Move &move) const noexcept {
+        return table_[static_cast<int>(side)][move_index(move)];
+    }
+
+    void update(const Side side, const Move &move, const int bonus) noexcept {
+        update_gravity(table_[static_cast<int>(side)][move_index(move)], bonus);
+    }
+
+    void clear() noexcept {
+        for (auto &side : table_) {
+            side.fill(0);
+        }
+    }
+
+   private:
+    alignas(64) std::array<std::array<std::int16_t, num_move_indices>, 2> table_ = {};
+};
+
+// The reply that last refuted each move
+class CounterMoves {
+   public:
+    [[nodiscard]] Move get(const Side side, const Move &prev) const noexcept {
+        return table_[static_cast<int>(side)][move_index(prev)];
+    }
+
+    void update(const Side side, const Move &prev, const Move &move) noexcept {
+        table_[static_cast<int>(side)][move_index(prev)] = move;
+    }
+
+    void clear() noexcept {
+        for (auto &side : table_) {
+            side.fill(Move::nomove());
+        }
+    }
+
+   private:
+    alignas(64) std::array<std::array<Move, num_move_indices>, 2> table_ = {};
+};
+
+// How well a move does as a reply to a move landing on a given square
+// The previous move's destination is enough since Ataxx only has one piece type
+class ContinuationHistory {
+   public:
+    [[nodiscard]] int get(const Move &prev, const Move &move) const noexcept {
+        return table_[target_index(prev)][move_index(move)];
+    }
+
+    void update(const Move &prev, const Move &move, const int bonus) noexcept {
+        update_gravity(table_[target_index(prev)][move_index(move)], bonus);
+    }
+
+    void clear() noexcept {
+        for (auto &row : table_) {
+            row.fill(0);
+        }
+    }
+
+   private:
+    alignas(64) std::array<std::array<std::int16_t, num_move_indices>, num_target_indices> table_ = {};
+};
+
+// Quiet moves that caused a cutoff at the same ply, most recent first
+class Killers {
+   public:
+    [[nodiscard]] const std::array<Move, num_killers> &get(const int ply) const noexcept {
+        return table_[ply];
+    }
+
+    void update(const int ply, const Move &move) noexcept {
+        auto &killers = table_[ply];
+        if (killers[0] != move) {
+            std::copy_backward(killers.begin(), killers.end() - 1, killers.end());
+            killers[0] = move;
+        }
+    }
+
+    void clear_ply(const int ply) noexcept {
+        table_[ply].fill(Move::nomove());
+    }
+
+    void clear() noexcept {
+        for (auto &killers : table_) {
+            killers.fill(Move::nomove());
+        }
+    }
+
+   private:
+    alignas(64) std::array<std::array<Move, num_killers>, max_killer_plies> table_ = {};
+};
+
+// Everything one search thread learns about quiet moves, about 260KB so keep
+// it on the heap and give each thread its own rather than sharing
+struct Histories {
+    ButterflyHistory butterfly;
+    CounterMoves counters;
+    ContinuationHistory continuation;
+    Killers killers;
+
+    void clear() noexcept {
+        butterfly.clear();
+        counters.clear();
+        continuation.clear();
+        killers.clear();
+    }
+};
+
+}  // namespace libataxx::search
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef LIBATAXX_MCTS_HPP
+#define LIBATAXX_MCTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "move.hpp"
+#include "position.hpp"
+#include "search.hpp"
+#include "timeman.hpp"
+
+namespace libataxx::mcts {
+
+// UCT search using the static evaluation as the value of new leaves
+// Limits::nodes counts iterations, Limits::depth is ignored and the search
+// stops at the soft limit if there is one, otherwise at movetime
+// The tree is kept between searches, a search from a position up to two
+// plies below the last root carries on from that subtree
+// Once the tree holds max_nodes nodes leaves stop being expanded and the
+// search carries on refining the tree it has
+class MCTS {
+   public:
+    // About 320MB of nodes
+    static constexpr std::uint32_t default_max_nodes = 1U << 24;
+
+    explicit MCTS(const float exploration = 1.4f, const std::uint32_t max_nodes = default_max_nodes)
+        : exploration_{exploration},
+          max_nodes_{std::clamp<std::uint32_t>(
+              max_nodes, 1 + max_moves, std::numeric_limits<std::uint32_t>::max() - max_moves)} {
+    }
+
+    [[nodiscard]] search::Result go(const Position &pos, const search::Limits &limits);
+
+    // Safe to call from another thread
+    void stop() noexcept {
+        stop_ = true;
+    }
+
+    // Safe to call from another thread
+    // The search so far continues with a time limit from now on, one sent
+    // just before go() applies to that search
+    void ponderhit(const timeman::Allocation &allocation) noexcept {
+        ponder_ms_ = (allocation.soft.count() > 0 ? allocation.soft : allocation.hard).count();
+        ponderhit_.store(true, std::memory_order_release);
+    }
+
+    void clear() noexcept {
+        nodes_.clear();
+    }
+
+    // Nodes in the tree, never more than max_nodes
+    [[nodiscard]] std::size_t size() const noexcept {
+        return nodes_.size();
+    }
+
+    // Visits carried over into the current search
+    [[nodiscard]] std::uint32_t reused() const noexcept {
+        return reused_;
+    }
+
+   private:
+    struct Node {
+        Move move;
+        std::uint32_t first_child = 0;
+        std::uint16_t num_children = 0;
+        bool expanded = false;
+        std::uint32_t visits = 0;
+        // Sum of results for the side that played the move
+        float total = 0.0f;
+    };
+
+    void iteration(const Position &root);
+
+    // Makes the node for the position the new root, false if there isn't one
+    [[nodiscard]] bool reuse(const Position &pos);
+
+    [[nodiscard]] std::uint32_t select(const Node &parent) const noexcept;
+
+    [[nodiscard]] std::uint32_t most_visited(const Node &parent) const noexcept;
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> path_;
+    Position root_;
+    std::uint32_t reused_ = 0;
+    float exploration_;
+    std::uint32_t max_nodes_;
+    std::atomic<bool> stop_ = false;
+    std::atomic<bool> ponderhit_ = false;
+    std::atomic<std::int64_t> ponder_ms_ = 0;
+};
+
+}  // namespace libataxx::mcts
+
+#endif
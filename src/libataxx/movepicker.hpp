@@ -0,0 +1,65 @@
+#ifndef LIBATAXX_MOVEPICKER_HPP
+#define LIBATAXX_MOVEPICKER_HPP
+
+#include <cstdint>
+#include "history.hpp"
+#include "move.hpp"
+#include "position.hpp"
+
+namespace libataxx::search {
+
+// Hands out moves one at a time in the order they're most likely to cut off:
+// the TT move, captures by stones flipped with singles first, then killers,
+// the counter move, and quiet singles before quiet doubles ordered by history
+// Each stage is only generated once the previous one runs out
+class MovePicker {
+   public:
+    enum class Stage : std::uint8_t
+    {
+        TTMove = 0,
+        GenerateCaptures,
+        Captures,
+        GenerateQuiets,
+        Quiets,
+        Done
+    };
+
+    // The previous move and ply are only used to look up the histories
+    MovePicker(const Position &pos,
+               const Move tt_move,
+               const Histories *histories = nullptr,
+               const Move prev = Move::nomove(),
+               const int ply = 0) noexcept
+        : pos_{pos}, tt_move_{tt_move}, histories_{histories}, prev_{prev}, ply_{ply} {
+    }
+
+    // Returns Move::nomove() once every legal move has been returned
+    [[nodiscard]] Move next() noexcept;
+
+    [[nodiscard]] Stage stage() const noexcept {
+        return stage_;
+    }
+
+   private:
+    void score_captures() noexcept;
+
+    void score_quiets() noexcept;
+
+    // Selection sort one move at a time, cutoffs leave the rest unsorted
+    [[nodiscard]] Move pick_best() noexcept;
+
+    const Position &pos_;
+    Move tt_move_;
+    const Histories *histories_;
+    Move prev_;
+    int ply_;
+    Stage stage_ = Stage::TTMove;
+    int index_ = 0;
+    int size_ = 0;
+    Move moves_[max_moves];
+    int scores_[max_moves];
+};
+
+}  // namespace libataxx::search
+
+#endif
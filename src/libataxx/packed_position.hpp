@@ -0,0 +1,119 @@
+#ifndef LIBATAXX_PACKED_POSITION_HPP
+#define LIBATAXX_PACKED_POSITION_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "bitboard.hpp"
+#include "position.hpp"
+#include "side.hpp"
+
+namespace libataxx {
+
+// A position in 16 bytes, for caches, datasets and checking table entries
+// Each square takes two bits, one in a black plane and one in a white plane,
+// with gaps set in both. Over the 49 bit compressed form that's 98 bits,
+// leaving room for the turn and both move counters:
+// - lo: black plane, then the low 15 bits of the white plane
+// - hi: the high 34 bits of the white plane, turn, halfmoves, fullmoves
+// Counters past max_halfmoves and max_fullmoves are stored as the maximum,
+// below that packing is lossless
+class PackedPosition {
+   public:
+    static constexpr unsigned int halfmove_bits = 9;
+    static constexpr unsigned int fullmove_bits = 20;
+    static constexpr unsigned int max_halfmoves = (1U << halfmove_bits) - 1;
+    static constexpr unsigned int max_fullmoves = (1U << fullmove_bits) - 1;
+
+    [[nodiscard]] constexpr PackedPosition() noexcept = default;
+
+    [[nodiscard]] constexpr explicit PackedPosition(const Position &pos) noexcept {
+        const auto black = (pos.get_black() | pos.get_gaps()).compressed();
+        const auto white = (pos.get_white() | pos.get_gaps()).compressed();
+        const std::uint64_t halfmoves = std::min(pos.get_halfmoves(), max_halfmoves);
+        const std::uint64_t fullmoves = std::min(pos.get_fullmoves(), max_fullmoves);
+
+        lo_ = black | (white << 49);
+        hi_ = (white >> 15) | (static_cast<std::uint64_t>(pos.get_turn() == Side::White) << turn_shift) |
+              (halfmoves << halfmove_shift) | (fullmoves << fullmove_shift);
+    }
+
+    // The hash is recalculated
+    [[nodiscard]] Position unpack() const noexcept {
+        auto pos = Position{get_black(), get_white(), get_gaps(), get_halfmoves(), get_fullmoves(), get_turn()};
+        pos.recalculate_hash();
+        return pos;
+    }
+
+    [[nodiscard]] constexpr Bitboard get_black() const noexcept {
+        return Bitboard::from_compressed(black_plane() & ~white_plane());
+    }
+
+    [[nodiscard]] constexpr Bitboard get_white() const noexcept {
+        return Bitboard::from_compressed(white_plane() & ~black_plane());
+    }
+
+    [[nodiscard]] constexpr Bitboard get_gaps() const noexcept {
+        return Bitboard::from_compressed(black_plane() & white_plane());
+    }
+
+    [[nodiscard]] constexpr Side get_turn() const noexcept {
+        return (hi_ >> turn_shift) & 1 ? Side::White : Side::Black;
+    }
+
+    [[nodiscard]] constexpr unsigned int get_halfmoves() const noexcept {
+        return static_cast<unsigned int>((hi_ >> halfmove_shift) & max_halfmoves);
+    }
+
+    [[nodiscard]] constexpr unsigned int get_fullmoves() const noexcept {
+        return static_cast<unsigned int>((hi_ >> fullmove_shift) & max_fullmoves);
+    }
+
+    // Mixes all 128 bits, unrelated to Position::get_hash()
+    [[nodiscard]] constexpr std::uint64_t hash() const noexcept {
+        return mix(lo_ ^ mix(hi_ + 0x9e3779b97f4a7c15ULL));
+    }
+
+    [[nodiscard]] constexpr bool operator==(const PackedPosition &rhs) const noexcept = default;
+
+    [[nodiscard]] constexpr auto operator<=>(const PackedPosition &rhs) const noexcept = default;
+
+   private:
+    static constexpr unsigned int turn_shift = 34;
+    static constexpr unsigned int halfmove_shift = turn_shift + 1;
+    static constexpr unsigned int fullmove_shift = halfmove_shift + halfmove_bits;
+
+    [[nodiscard]] constexpr std::uint64_t black_plane() const noexcept {
+        return lo_ & 0x1ffffffffffffULL;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t white_plane() const noexcept {
+        return (lo_ >> 49) | ((hi_ & 0x3ffffffffULL) << 15);
+    }
+
+    // splitmix64's finaliser
+    [[nodiscard]] static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    std::uint64_t lo_ = 0;
+    std::uint64_t hi_ = 0;
+};
+
+static_assert(sizeof(PackedPosition) == 16);
+static_assert(PackedPosition::fullmove_bits + PackedPosition::halfmove_bits + 1 + 34 == 64);
+
+}  // namespace libataxx
+
+template <>
+struct std::hash<libataxx::PackedPosition> {
+    [[nodiscard]] std::size_t operator()(const libataxx::PackedPosition &packed) const noexcept {
+        return packed.hash();
+    }
+};
+
+#endif
@@ -1,11 +1,13 @@
 #ifndef LIBATAXX_PGN_HPP
 #define LIBATAXX_PGN_HPP
 
+#include <istream>
 #include <optional>
 #include <ostream>
 #include <string>
 #include <vector>
 #include "move.hpp"
+#include "position.hpp"
 
 namespace libataxx::pgn {
 
@@ -16,6 +18,45 @@ class Node {
     [[nodiscard]] Node(Node *parent, const Move move, const int ply) : parent_{parent}, move_{move}, ply_{ply} {
     }
 
+    // Children point back at their parent, so copies and moves have to update them
+    [[nodiscard]] Node(const Node &other)
+        : parent_{other.parent_},
+          move_{other.move_},
+          ply_{other.ply_},
+          comment_{other.comment_},
+          children_{other.children_} {
+        adopt_children();
+    }
+
+    [[nodiscard]] Node(Node &&other) noexcept
+        : parent_{other.parent_},
+          move_{other.move_},
+          ply_{other.ply_},
+          comment_{std::move(other.comment_)},
+          children_{std::move(other.children_)} {
+        adopt_children();
+    }
+
+    Node &operator=(const Node &other) {
+        parent_ = other.parent_;
+        move_ = other.move_;
+        ply_ = other.ply_;
+        comment_ = other.comment_;
+        children_ = other.children_;
+        adopt_children();
+        return *this;
+    }
+
+    Node &operator=(Node &&other) noexcept {
+        parent_ = other.parent_;
+        move_ = other.move_;
+        ply_ = other.ply_;
+        comment_ = std::move(other.comment_);
+        children_ = std::move(other.children_);
+        adopt_children();
+        return *this;
+    }
+
     [[nodiscard]] constexpr bool is_root() const noexcept {
         return parent_ == nullptr;
     }
@@ -54,6 +95,10 @@ class Node {
         return children_;
     }
 
+    [[nodiscard]] std::vector<Node> &children() noexcept {
+        return children_;
+    }
+
     [[nodiscard]] constexpr Move move() const noexcept {
         return move_;
     }
@@ -132,6 +177,12 @@ class Node {
     }
 
    private:
+    void adopt_children() noexcept {
+        for (auto &child : children_) {
+            child.parent_ = this;
+        }
+    }
+
     Node *parent_ = nullptr;
     Move move_;
     int ply_ = 0;
@@ -218,6 +269,16 @@ inline std::ostream &operator<<(std::ostream &os, const PGN &pgn) {
     return os;
 }
 
+// Reads the next game from the stream, returns nothing once the stream is exhausted
+// Throws std::invalid_argument on malformed movetext
+[[nodiscard]] std::optional<PGN> read(std::istream &is);
+
+// Taken from the FEN header if there is one
+[[nodiscard]] Position start_position(const PGN &pgn) noexcept;
+
+// Taken from the Result header
+[[nodiscard]] Result get_result(const PGN &pgn) noexcept;
+
 }  // namespace libataxx::pgn
 
 #endif
@@ -2,7 +2,9 @@
 #define LIBATAXX_POSITION_HPP
 
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "bitboard.hpp"
 #include "move.hpp"
@@ -19,11 +21,37 @@ enum class Result
     Draw
 };
 
+enum class FenError
+{
+    None = 0,
+    InvalidBoard,
+    InvalidTurn,
+    InvalidHalfmoves,
+    InvalidFullmoves,
+    TrailingCharacters
+};
+
+// Moves made at one ply of a perft, sorted by type and by what they lead to
+struct PerftStats {
+    std::uint64_t nodes = 0;
+    std::uint64_t singles = 0;
+    std::uint64_t doubles = 0;
+    std::uint64_t passes = 0;
+    // Moves that flip at least one stone
+    std::uint64_t captures = 0;
+    // Stones flipped over all moves
+    std::uint64_t flips = 0;
+    std::uint64_t gameovers = 0;
+    std::uint64_t black_wins = 0;
+    std::uint64_t white_wins = 0;
+    std::uint64_t draws = 0;
+};
+
 class Position {
    public:
     [[nodiscard]] constexpr Position() noexcept = default;
 
-    [[nodiscard]] explicit Position(const std::string &fen) noexcept {
+    [[nodiscard]] explicit Position(const std::string_view fen) noexcept {
         set_fen(fen);
     }
 
@@ -43,10 +71,26 @@ class Position {
         return npos;
     }
 
-    void set_fen(const std::string &fen) noexcept;
+    // The position is left unchanged if the FEN is invalid
+    FenError set_fen(const std::string_view fen) noexcept;
+
+    [[nodiscard]] static std::optional<Position> from_fen(const std::string_view fen) noexcept {
+        Position pos;
+        if (pos.set_fen(fen) != FenError::None) {
+            return std::nullopt;
+        }
+        return pos;
+    }
 
     [[nodiscard]] std::string get_fen() const noexcept;
 
+    // Board, turn and two 10 digit counters
+    static constexpr std::size_t fen_buffer_size = 80;
+
+    // Writes the FEN to a buffer of at least fen_buffer_size bytes without a
+    // null terminator, returns the end of the written characters
+    char *write_fen(char *out) const noexcept;
+
     [[nodiscard]] constexpr Side get_turn() const noexcept {
         return turn_;
     }
@@ -57,6 +101,10 @@ class Position {
 
     [[nodiscard]] std::uint64_t perft(const int depth) const noexcept;
 
+    // One entry per ply, the first counts the moves from this position
+    // The nodes of the last entry match perft(depth)
+    [[nodiscard]] std::vector<PerftStats> perft_stats(const int depth) const;
+
     // "legal" functions take gameover into consideration
 
     [[nodiscard]] int count_legal_moves() const noexcept;
@@ -212,11 +260,11 @@ class Position {
         return hash_;
     }
 
-    [[nodiscard]] unsigned int get_halfmoves() const noexcept {
+    [[nodiscard]] constexpr unsigned int get_halfmoves() const noexcept {
         return halfmoves_;
     }
 
-    [[nodiscard]] unsigned int get_fullmoves() const noexcept {
+    [[nodiscard]] constexpr unsigned int get_fullmoves() const noexcept {
         return fullmoves_;
     }
 
@@ -238,7 +286,29 @@ class Position {
         return get_reachable(get_side(s), get_empty());
     }
 
+    // The transforms that map the gaps onto themselves, bit n is set for the
+    // nth transform of get_minimal_hash(), the same order as Transform in
+    // symmetry.hpp. The first, no transform, is always set
+    [[nodiscard]] constexpr std::uint8_t get_symmetries() const noexcept {
+        std::uint8_t symmetries = 1;
+        symmetries |= (gaps_.rot90() == gaps_) << 1;
+        symmetries |= (gaps_.rot180() == gaps_) << 2;
+        symmetries |= (gaps_.rot270() == gaps_) << 3;
+        symmetries |= (gaps_.flip_horizontal() == gaps_) << 4;
+        symmetries |= (gaps_.flip_vertical() == gaps_) << 5;
+        symmetries |= (gaps_.flip_diagA7G1() == gaps_) << 6;
+        symmetries |= (gaps_.flip_diagA1G7() == gaps_) << 7;
+        return symmetries;
+    }
+
+    // Transforms that move the gaps lead to positions that can't come up in
+    // the same game, so only the gaps' symmetries are tried
     [[nodiscard]] constexpr std::uint64_t get_minimal_hash() const noexcept {
+        return get_minimal_hash(get_symmetries());
+    }
+
+    // For when get_symmetries() is already known, such as from a Board
+    [[nodiscard]] constexpr std::uint64_t get_minimal_hash(const std::uint8_t symmetries) const noexcept {
         enum Transform
         {
             None = 0,
@@ -255,31 +325,31 @@ class Position {
         auto n = pieces_[0];
 
         // Find minimal transformation
-        if (pieces_[0].rot90() < n) {
+        if ((symmetries >> Transform::Rot90 & 1) && pieces_[0].rot90() < n) {
             n = pieces_[0].rot90();
             transformation = Transform::Rot90;
         }
-        if (pieces_[0].rot180() < n) {
+        if ((symmetries >> Transform::Rot180 & 1) && pieces_[0].rot180() < n) {
             n = pieces_[0].rot180();
             transformation = Transform::Rot180;
         }
-        if (pieces_[0].rot270() < n) {
+        if ((symmetries >> Transform::Rot270 & 1) && pieces_[0].rot270() < n) {
             n = pieces_[0].rot270();
             transformation = Transform::Rot270;
         }
-        if (pieces_[0].flip_horizontal() < n) {
+        if ((symmetries >> Transform::FlipH & 1) && pieces_[0].flip_horizontal() < n) {
             n = pieces_[0].flip_horizontal();
             transformation = Transform::FlipH;
         }
-        if (pieces_[0].flip_vertical() < n) {
+        if ((symmetries >> Transform::FlipV & 1) && pieces_[0].flip_vertical() < n) {
             n = pieces_[0].flip_vertical();
             transformation = Transform::FlipV;
         }
-        if (pieces_[0].flip_diagA7G1() < n) {
+        if ((symmetries >> Transform::A7G1 & 1) && pieces_[0].flip_diagA7G1() < n) {
             n = pieces_[0].flip_diagA7G1();
             transformation = Transform::A7G1;
         }
-        if (pieces_[0].flip_diagA1G7() < n) {
+        if ((symmetries >> Transform::A1G7 & 1) && pieces_[0].flip_diagA1G7() < n) {
             n = pieces_[0].flip_diagA1G7();
             transformation = Transform::A1G7;
         }
@@ -357,6 +427,11 @@ class Position {
 
     [[nodiscard]] std::uint64_t calculate_hash() const noexcept;
 
+    // Positions built from bitboards start without a hash
+    void recalculate_hash() noexcept {
+        hash_ = calculate_hash();
+    }
+
     [[nodiscard]] std::uint64_t predict_hash(const Move &move) const noexcept;
 
    private:
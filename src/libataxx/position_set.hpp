@@ -0,0 +1,113 @@
+#ifndef LIBATAXX_POSITION_SET_HPP
+#define LIBATAXX_POSITION_SET_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "position.hpp"
+
+namespace libataxx {
+
+struct PositionSetOptions {
+    // Rounded up to a power of two
+    std::size_t shards = 64;
+    // Skip lookups in spilled keys for keys that were never seen before
+    bool bloom = false;
+    std::size_t bloom_bits = 1 << 27;
+    // Keys kept in memory across all shards before a shard spills its keys
+    // to a sorted file on disk, zero to never spill
+    std::size_t max_memory_keys = 0;
+    std::string spill_directory = ".";
+    // Spilled files a shard keeps before merging them, every lookup searches
+    // each file. Files are also merged with older ones no larger than them,
+    // so there are only ever a few per doubling of the keys on disk
+    std::size_t max_runs = 8;
+};
+
+// A set of positions keyed by their canonical symmetric hash
+// Inserts and lookups are safe to call from many threads at once
+class PositionSet {
+   public:
+    explicit PositionSet(const PositionSetOptions &options = {});
+
+    ~PositionSet();
+
+    PositionSet(const PositionSet &) = delete;
+
+    PositionSet &operator=(const PositionSet &) = delete;
+
+    [[nodiscard]] static std::uint64_t key(const Position &pos) noexcept;
+
+    // Returns true if the position was not already in the set
+    bool insert(const Position &pos) {
+        return insert_key(key(pos));
+    }
+
+    bool insert_key(std::uint64_t key);
+
+    [[nodiscard]] bool contains(const Position &pos) const {
+        return contains_key(key(pos));
+    }
+
+    [[nodiscard]] bool contains_key(std::uint64_t key) const;
+
+    [[nodiscard]] std::uint64_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] std::uint64_t spilled() const noexcept {
+        return spilled_;
+    }
+
+   private:
+    struct Run {
+        int fd = -1;
+        std::uint64_t size = 0;
+        std::string path;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mtx;
+        std::vector<std::uint64_t> table;
+        std::size_t count = 0;
+        std::vector<Run> runs;
+        // Names new files
+        std::uint64_t next_run = 0;
+    };
+
+    [[nodiscard]] Shard &shard(const std::uint64_t key) const noexcept {
+        return shards_[key >> shard_shift_];
+    }
+
+    [[nodiscard]] bool bloom_test_and_set(const std::uint64_t key) noexcept;
+
+    [[nodiscard]] bool bloom_test(const std::uint64_t key) const noexcept;
+
+    [[nodiscard]] bool in_memory(const Shard &shard, const std::uint64_t key) const noexcept;
+
+    [[nodiscard]] bool in_runs(const Shard &shard, const std::uint64_t key) const;
+
+    void add_to_memory(Shard &shard, const std::uint64_t key);
+
+    void spill(Shard &shard, const std::size_t idx);
+
+    [[nodiscard]] Run create_run(Shard &shard, const std::size_t idx) const;
+
+    [[nodiscard]] Run merge_runs(Shard &shard, const std::size_t idx, const Run &a, const Run &b) const;
+
+    PositionSetOptions options_;
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t num_shards_ = 0;
+    int shard_shift_ = 0;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> bloom_;
+    std::size_t bloom_words_ = 0;
+    std::atomic<std::uint64_t> size_ = 0;
+    std::atomic<std::uint64_t> spilled_ = 0;
+};
+
+}  // namespace libataxx
+
+#endif
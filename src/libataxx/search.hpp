@@ -0,0 +1,243 @@
+#ifndef LIBATAXX_SEARCH_HPP
+#define LIBATAXX_SEARCH_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "history.hpp"
+#include "move.hpp"
+#include "position.hpp"
+#include "timeman.hpp"
+
+namespace libataxx::search {
+
+constexpr int max_ply = 128;
+constexpr int mate_score = 30000;
+constexpr int mate_bound = mate_score - max_ply;
+
+static_assert(max_ply <= max_killer_plies);
+
+// Zero means no limit
+// Movetime is a hard limit, no iteration starts after the soft limit scaled by
+// the time manager
+struct Limits {
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    std::chrono::milliseconds movetime{0};
+    std::chrono::milliseconds soft{0};
+    // How many of the best moves to find
+    int multipv = 1;
+};
+
+struct Info {
+    int depth = 0;
+    int score = 0;
+    std::uint64_t nodes = 0;
+    std::chrono::milliseconds time{0};
+    std::vector<Move> pv;
+    // Which line this is in a multi-PV search, zero otherwise
+    int multipv = 0;
+};
+
+// One of the best moves at the root, lines can be at different depths when
+// the search stops part way through an iteration
+struct Line {
+    Move move = Move::nomove();
+    int score = 0;
+    int depth = 0;
+    std::vector<Move> pv;
+};
+
+struct Result {
+    Move bestmove = Move::nomove();
+    int score = 0;
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    std::vector<Move> pv;
+    // Best first, the first line matches the fields above
+    std::vector<Line> lines;
+};
+
+// Pruning and reduction settings, a depth of zero turns the feature off
+// Margins are in centistones like the evaluation
+struct Params {
+    // Null move pruning, skipped when the side to move must pass since the
+    // pass is then its only move, and with few empties left where moving can
+    // be worse than passing. Searches deep enough are verified without it
+    int nmp_depth = 3;
+    int nmp_reduction = 3;
+    int nmp_verify_depth = 8;
+    int nmp_min_empty = 8;
+    // Late move reductions in hundredths of a ply, less for each stone captured
+    int lmr_depth = 3;
+    int lmr_moves = 3;
+    int lmr_base = 50;
+    int lmr_divisor = 250;
+    // Quiet moves that can't lift the evaluation above alpha are skipped
+    int futility_depth = 3;
+    int futility_margin = 150;
+    // Positions far enough above beta fail high on the evaluation
+    int rfp_depth = 4;
+    int rfp_margin = 200;
+    // Positions far below alpha are searched a ply shallower
+    int razor_depth = 2;
+    int razor_margin = 300;
+};
+
+struct ParamInfo {
+    const char *name;
+    int Params::*value;
+    int min;
+    int max;
+};
+
+inline constexpr std::array<ParamInfo, 14> param_info = {{
+    {"NMPDepth", &Params::nmp_depth, 0, 32},
+    {"NMPReduction", &Params::nmp_reduction, 1, 8},
+    {"NMPVerifyDepth", &Params::nmp_verify_depth, 0, 128},
+    {"NMPMinEmpty", &Params::nmp_min_empty, 0, 49},
+    {"LMRDepth", &Params::lmr_depth, 0, 32},
+    {"LMRMoves", &Params::lmr_moves, 1, 64},
+    {"LMRBase", &Params::lmr_base, 0, 400},
+    {"LMRDivisor", &Params::lmr_divisor, 50, 1000},
+    {"FutilityDepth", &Params::futility_depth, 0, 16},
+    {"FutilityMargin", &Params::futility_margin, 0, 2000},
+    {"RFPDepth", &Params::rfp_depth, 0, 16},
+    {"RFPMargin", &Params::rfp_margin, 0, 2000},
+    {"RazorDepth", &Params::razor_depth, 0, 16},
+    {"RazorMargin", &Params::razor_margin, 0, 2000},
+}};
+
+// Sets a parameter by its name in param_info, clamped to its range
+// Returns false if there's no such parameter
+bool set_param(Params &params, const std::string &name, const int value) noexcept;
+
+// Every depth set to zero, plain alpha-beta
+[[nodiscard]] Params no_pruning() noexcept;
+
+// Stone difference from the side to move's point of view
+[[nodiscard]] constexpr int evaluate(const Position &pos) noexcept {
+    return 100 * (pos.get_us().count() - pos.get_them().count());
+}
+
+// Score of a finished game from the side to move's point of view
+[[nodiscard]] inline int terminal_score(const Position &pos, const int ply) noexcept {
+    switch (pos.get_result()) {
+        case libataxx::Result::BlackWin:
+            return pos.get_turn() == Side::Black ? mate_score - ply : -mate_score + ply;
+        case libataxx::Result::WhiteWin:
+            return pos.get_turn() == Side::White ? mate_score - ply : -mate_score + ply;
+        default:
+            return 0;
+    }
+}
+
+// Alpha-beta with iterative deepening and a transposition table
+// The table and move histories persist between searches until clear() is called
+// Each instance is meant to be driven by one thread
+class Search {
+   public:
+    explicit Search(const std::size_t tt_mb = 16);
+
+    [[nodiscard]] Result go(const Position &pos, const Limits &limits);
+
+    // Safe to call from another thread
+    void stop() noexcept {
+        stop_ = true;
+    }
+
+    // Safe to call from another thread
+    // Turns a search without time limits, such as a ponder search, into one
+    // on the allocation from now on. The table stays warm for the next search
+    // if the ponder move isn't played. One sent just before go() applies to
+    // that search
+    void ponderhit(const timeman::Allocation &allocation) noexcept {
+        ponder_soft_ = allocation.soft.count();
+        ponder_hard_ = allocation.hard.count();
+        ponderhit_.store(true, std::memory_order_release);
+    }
+
+    void clear() noexcept;
+
+    void resize(const std::size_t tt_mb);
+
+    void set_params(const Params &params) noexcept;
+
+    [[nodiscard]] const Params &params() const noexcept {
+        return params_;
+    }
+
+    void set_info_handler(std::function<void(const Info &)> handler) {
+        info_handler_ = std::move(handler);
+    }
+
+   private:
+    enum class Bound : std::uint8_t
+    {
+        None = 0,
+        Exact,
+        Lower,
+        Upper,
+    };
+
+    struct TTEntry {
+        std::uint64_t hash = 0;
+        Move move;
+        std::int16_t score = 0;
+        std::int8_t depth = 0;
+        Bound bound = Bound::None;
+    };
+
+    static constexpr int lmr_size = 64;
+
+    [[nodiscard]] int alphabeta(const Position &pos, int alpha, int beta, int depth, const int ply);
+
+    [[nodiscard]] bool should_stop() noexcept;
+
+    [[nodiscard]] std::vector<Move> get_pv() const;
+
+    // Rewards the quiet move that caused a cutoff and penalises the quiets
+    // searched before it
+    void update_histories(const Position &pos,
+                          const Move &best,
+                          const Move *quiets,
+                          const int num_quiets,
+                          const int depth,
+                          const int ply) noexcept;
+
+    [[nodiscard]] TTEntry &tt_entry(const std::uint64_t hash) noexcept {
+        return tt_[hash % tt_.size()];
+    }
+
+    std::vector<TTEntry> tt_;
+    std::unique_ptr<Histories> histories_;
+    // Moves made to reach each ply
+    Move stack_[max_ply];
+    Move pv_[max_ply][max_ply];
+    int pv_length_[max_ply] = {};
+    std::function<void(const Info &)> info_handler_;
+    Params params_;
+    // Reductions by depth and moves searched in whole plies
+    int lmr_[lmr_size][lmr_size] = {};
+    // Set while a null move cutoff is being verified
+    bool verifying_ = false;
+    // Root moves skipped to find the next multi-PV line
+    std::vector<Move> excluded_;
+    std::atomic<bool> stop_ = false;
+    std::atomic<bool> ponderhit_ = false;
+    std::atomic<std::int64_t> ponder_soft_ = 0;
+    std::atomic<std::int64_t> ponder_hard_ = 0;
+    Limits limits_;
+    timeman::TimeManager tm_;
+    std::uint64_t nodes_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace libataxx::search
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef LIBATAXX_SPRT_HPP
+#define LIBATAXX_SPRT_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace libataxx::sprt {
+
+enum class Status
+{
+    Continue,
+    AcceptH0,
+    AcceptH1
+};
+
+// Game pair outcomes counted by the points scored over both games
+// counts[0] is two losses, counts[4] is two wins
+struct Pentanomial {
+    // Half points scored over the pair, 0 to 4
+    void add(const int half_points) noexcept {
+        counts[half_points]++;
+    }
+
+    [[nodiscard]] std::uint64_t pairs() const noexcept {
+        return counts[0] + counts[1] + counts[2] + counts[3] + counts[4];
+    }
+
+    // Mean score per game, between 0 and 1
+    [[nodiscard]] double mean() const noexcept;
+
+    // Variance of the per game score of a pair
+    [[nodiscard]] double variance() const noexcept;
+
+    std::array<std::uint64_t, 5> counts = {};
+};
+
+struct Elo {
+    double elo = 0.0;
+    // Half the width of the 95% confidence interval
+    double error = 0.0;
+};
+
+// Logistic Elo difference for an expected score and the reverse
+[[nodiscard]] double score_to_elo(double score) noexcept;
+
+[[nodiscard]] double elo_to_score(double elo) noexcept;
+
+[[nodiscard]] Elo elo(const Pentanomial &penta) noexcept;
+
+// Likelihood of superiority, the chance the first engine is stronger
+[[nodiscard]] double los(const Pentanomial &penta) noexcept;
+
+// Sequential probability ratio test of H0: elo = elo0 against H1: elo = elo1
+// using the generalised log-likelihood ratio of the pentanomial game pair results
+class SPRT {
+   public:
+    explicit SPRT(double elo0 = 0.0, double elo1 = 5.0, double alpha = 0.05, double beta = 0.05) noexcept;
+
+    // Returns the status after adding the result of another game pair
+    Status add(int half_points) noexcept;
+
+    [[nodiscard]] Status status() const noexcept;
+
+    [[nodiscard]] double llr() const noexcept;
+
+    [[nodiscard]] double lower_bound() const noexcept {
+        return lower_;
+    }
+
+    [[nodiscard]] double upper_bound() const noexcept {
+        return upper_;
+    }
+
+    [[nodiscard]] const Pentanomial &pentanomial() const noexcept {
+        return penta_;
+    }
+
+   private:
+    Pentanomial penta_;
+    double elo0_;
+    double elo1_;
+    double lower_;
+    double upper_;
+};
+
+}  // namespace libataxx::sprt
+
+#endif
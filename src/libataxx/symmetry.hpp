@@ -0,0 +1,150 @@
+#ifndef LIBATAXX_SYMMETRY_HPP
+#define LIBATAXX_SYMMETRY_HPP
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include "bitboard.hpp"
+#include "move.hpp"
+#include "position.hpp"
+#include "square.hpp"
+
+namespace libataxx {
+
+enum class Transform : std::uint8_t
+{
+    None = 0,
+    Rot90,
+    Rot180,
+    Rot270,
+    FlipH,
+    FlipV,
+    A7G1,
+    A1G7
+};
+
+constexpr std::array<Transform, 8> transforms = {
+    Transform::None,
+    Transform::Rot90,
+    Transform::Rot180,
+    Transform::Rot270,
+    Transform::FlipH,
+    Transform::FlipV,
+    Transform::A7G1,
+    Transform::A1G7,
+};
+
+[[nodiscard]] constexpr Transform inverse(const Transform t) noexcept {
+    switch (t) {
+        case Transform::Rot90:
+            return Transform::Rot270;
+        case Transform::Rot270:
+            return Transform::Rot90;
+        default:
+            return t;
+    }
+}
+
+[[nodiscard]] constexpr Bitboard transform(const Bitboard &bb, const Transform t) noexcept {
+    switch (t) {
+        case Transform::Rot90:
+            return bb.rot90();
+        case Transform::Rot180:
+            return bb.rot180();
+        case Transform::Rot270:
+            return bb.rot270();
+        case Transform::FlipH:
+            return bb.flip_horizontal();
+        case Transform::FlipV:
+            return bb.flip_vertical();
+        case Transform::A7G1:
+            return bb.flip_diagA7G1();
+        case Transform::A1G7:
+            return bb.flip_diagA1G7();
+        default:
+            return bb;
+    }
+}
+
+[[nodiscard]] constexpr Square transform(const Square &sq, const Transform t) noexcept {
+    return Square{transform(Bitboard{sq}, t).lsbll()};
+}
+
+[[nodiscard]] constexpr Move transform(const Move &move, const Transform t) noexcept {
+    if (move == Move::nullmove() || move == Move::nomove()) {
+        return move;
+    }
+    if (move.is_single()) {
+        return Move{transform(move.to(), t)};
+    }
+    return Move{transform(move.from(), t), transform(move.to(), t)};
+}
+
+[[nodiscard]] inline Position transform(const Position &pos, const Transform t) noexcept {
+    auto npos = Position{transform(pos.get_black(), t),
+                         transform(pos.get_white(), t),
+                         transform(pos.get_gaps(), t),
+                         pos.get_halfmoves(),
+                         pos.get_fullmoves(),
+                         pos.get_turn()};
+    npos.recalculate_hash();
+    return npos;
+}
+
+// Every transform, for comparing positions with different gaps
+constexpr std::uint8_t all_symmetries = 0xFF;
+
+// Symmetries as returned by Position::get_symmetries()
+[[nodiscard]] constexpr bool has_symmetry(const std::uint8_t symmetries, const Transform t) noexcept {
+    return (symmetries >> static_cast<int>(t)) & 1;
+}
+
+// The smallest hash over the given transforms along with the transform that
+// produced it. Unlike Position::get_minimal_hash() this is the same for
+// every member of a symmetry class, even when the black stones are symmetric
+[[nodiscard]] inline std::pair<std::uint64_t, Transform> canonical(const Position &pos,
+                                                                   const std::uint8_t symmetries) noexcept {
+    auto best = std::make_pair(pos.get_hash(), Transform::None);
+    for (std::size_t i = 1; i < transforms.size(); ++i) {
+        if (!has_symmetry(symmetries, transforms[i])) {
+            continue;
+        }
+        const auto hash = transform(pos, transforms[i]).get_hash();
+        if (hash < best.first) {
+            best = {hash, transforms[i]};
+        }
+    }
+    return best;
+}
+
+// Only the transforms that keep the gaps where they are, the others lead to
+// positions that can't come up in the same game
+[[nodiscard]] inline std::pair<std::uint64_t, Transform> canonical(const Position &pos) noexcept {
+    return canonical(pos, pos.get_symmetries());
+}
+
+[[nodiscard]] inline std::uint64_t canonical_hash(const Position &pos, const std::uint8_t symmetries) noexcept {
+    return canonical(pos, symmetries).first;
+}
+
+[[nodiscard]] inline std::uint64_t canonical_hash(const Position &pos) noexcept {
+    return canonical(pos).first;
+}
+
+static_assert(transform(Square{SquareIndex::A1}, Transform::FlipH) == Square{SquareIndex::G1});
+static_assert(transform(Square{SquareIndex::A1}, Transform::FlipV) == Square{SquareIndex::A7});
+static_assert(transform(Square{SquareIndex::B1}, Transform::Rot180) == Square{SquareIndex::F7});
+static_assert(transform(transform(Square{SquareIndex::B1}, Transform::Rot90), Transform::Rot270) ==
+              Square{SquareIndex::B1});
+
+// Position::get_symmetries() uses the same order
+static_assert(Position{Bitboard{}, Bitboard{}, Bitboard{0x1ULL}, 0, 0, Side::Black}.get_symmetries() ==
+              (1 << static_cast<int>(Transform::None) | 1 << static_cast<int>(Transform::A1G7)));
+static_assert(Position{Bitboard{}, Bitboard{}, Bitboard{0x41ULL}, 0, 0, Side::Black}.get_symmetries() ==
+              (1 << static_cast<int>(Transform::None) | 1 << static_cast<int>(Transform::FlipH)));
+static_assert(Position{Bitboard{}, Bitboard{}, Bitboard{0x40ULL}, 0, 0, Side::Black}.get_symmetries() ==
+              (1 << static_cast<int>(Transform::None) | 1 << static_cast<int>(Transform::A7G1)));
+
+}  // namespace libataxx
+
+#endif
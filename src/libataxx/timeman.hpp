@@ -0,0 +1,106 @@
+#ifndef LIBATAXX_TIMEMAN_HPP
+#define LIBATAXX_TIMEMAN_HPP
+
+#include <chrono>
+#include <cstdint>
+#include "move.hpp"
+#include "position.hpp"
+
+namespace libataxx::timeman {
+
+// The side to move's clock, zero time means there's no clock
+struct Clock {
+    std::chrono::milliseconds time{0};
+    std::chrono::milliseconds inc{0};
+    int movestogo = 0;
+};
+
+struct Policy {
+    // Kept back from every move for communication delays
+    std::chrono::milliseconds move_overhead{30};
+    // Moves left are estimated from the empty squares when movestogo is
+    // missing, or when the board fills up before it runs out
+    int movestogo_margin = 8;
+    int min_movestogo = 6;
+    int max_movestogo = 30;
+    // Percent of the increment added to each move's share
+    int inc_percent = 50;
+    // The hard limit as a multiple of the soft limit and a share of the clock
+    double hard_scale = 3.0;
+    double max_clock_share = 0.5;
+    // Each iteration with the same best move takes this much off the soft
+    // limit, down to min_stability
+    double stability_step = 0.1;
+    double max_stability = 1.3;
+    double min_stability = 0.6;
+    // A score drop of score_drop_scale centistones doubles the soft limit
+    int score_drop_scale = 200;
+    // The clock is read once every this many nodes
+    std::uint64_t check_interval = 1024;
+};
+
+struct Allocation {
+    // Don't start another iteration after this, zero for no limit
+    std::chrono::milliseconds soft{0};
+    // Stop searching, zero for no limit
+    std::chrono::milliseconds hard{0};
+};
+
+// Moves the side to move is expected to make before the game or the time
+// control ends, each side fills about one square a move
+[[nodiscard]] int expected_moves(const Clock &clock, const Position &pos, const Policy &policy = {}) noexcept;
+
+[[nodiscard]] Allocation allocate(const Clock &clock, const Position &pos, const Policy &policy = {}) noexcept;
+
+// Tracks one search against its allocation
+// Iterative deepening reports each finished iteration, stable best moves
+// shrink the soft limit and falling scores stretch it up to the hard limit
+class TimeManager {
+   public:
+    TimeManager() = default;
+
+    explicit TimeManager(const Allocation &allocation, const Policy &policy = {}) noexcept
+        : allocation_{allocation}, policy_{policy} {
+    }
+
+    void start() noexcept;
+
+    // Starts the clock again on a new allocation, what was learnt from the
+    // iterations so far is kept
+    void restart(const Allocation &allocation) noexcept;
+
+    void update(const int depth, const Move &bestmove, const int score) noexcept;
+
+    // Whether another iteration is worth starting
+    [[nodiscard]] bool should_continue() const noexcept;
+
+    // Only reads the clock every check_interval nodes
+    [[nodiscard]] bool should_stop(const std::uint64_t nodes) noexcept;
+
+    // The current multiple of the soft limit
+    [[nodiscard]] double scale() const noexcept;
+
+    [[nodiscard]] std::chrono::milliseconds elapsed() const noexcept {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_);
+    }
+
+    [[nodiscard]] const Allocation &allocation() const noexcept {
+        return allocation_;
+    }
+
+   private:
+    Allocation allocation_;
+    Policy policy_;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+    std::uint64_t next_check_ = 0;
+    bool expired_ = false;
+    Move bestmove_ = Move::nomove();
+    int stable_iterations_ = 0;
+    int last_score_ = 0;
+    int score_drop_ = 0;
+    int iterations_ = 0;
+};
+
+}  // namespace libataxx::timeman
+
+#endif
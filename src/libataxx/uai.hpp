@@ -0,0 +1,249 @@
+#ifndef LIBATAXX_UAI_HPP
+#define LIBATAXX_UAI_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mcts.hpp"
+#include "move.hpp"
+#include "position.hpp"
+#include "search.hpp"
+#include "timeman.hpp"
+
+namespace libataxx::uai {
+
+struct Option {
+    enum class Type
+    {
+        Check,
+        Spin,
+        String,
+        Button
+    };
+
+    [[nodiscard]] explicit operator std::string() const;
+
+    std::string name;
+    Type type = Type::String;
+    std::string default_value;
+    int min = 0;
+    int max = 0;
+};
+
+// Everything "go" can be told, zero means not given
+struct GoParams {
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    std::chrono::milliseconds movetime{0};
+    std::chrono::milliseconds btime{0};
+    std::chrono::milliseconds wtime{0};
+    std::chrono::milliseconds binc{0};
+    std::chrono::milliseconds winc{0};
+    int movestogo = 0;
+    bool infinite = false;
+    bool ponder = false;
+};
+
+[[nodiscard]] GoParams parse_go(const std::string &line);
+
+// The side to move's clock from "go"
+[[nodiscard]] timeman::Clock get_clock(const GoParams &params, const Side side) noexcept;
+
+// How long to think for, zero for no limit
+// The hard limit is enforced by the driver, the soft limit is passed on to the
+// engine in search::Limits
+using TimeManager = std::function<timeman::Allocation(const GoParams &params, const Position &pos)>;
+
+// Movetime if given as both limits, otherwise timeman::allocate()
+[[nodiscard]] timeman::Allocation default_time_manager(const GoParams &params, const Position &pos) noexcept;
+
+// "info depth 5 score cp 100 nodes 1000 nps 50000 time 20 pv g2 a2"
+// "multipv 2" follows the depth for the lines of a multi-PV search
+[[nodiscard]] std::string format_info(const search::Info &info);
+
+class Engine {
+   public:
+    using InfoHandler = std::function<void(const search::Info &)>;
+
+    virtual ~Engine() = default;
+
+    [[nodiscard]] virtual std::string name() const = 0;
+
+    [[nodiscard]] virtual std::string author() const = 0;
+
+    [[nodiscard]] virtual std::vector<Option> options() const {
+        return {};
+    }
+
+    virtual void set_option([[maybe_unused]] const std::string &name, [[maybe_unused]] const std::string &value) {
+    }
+
+    virtual void new_game() {
+    }
+
+    // Runs on the driver's search thread
+    // The movetime and soft limits are the time manager's budget and are zero
+    // while pondering, the driver calls stop() when the budget runs out
+    [[nodiscard]] virtual search::Result go(const Position &pos,
+                                            const search::Limits &limits,
+                                            const InfoHandler &info) = 0;
+
+    // Called from the input thread, possibly more than once and possibly
+    // just before go() starts
+    virtual void stop() noexcept = 0;
+
+    // Called from the input thread when a ponder search becomes a normal one,
+    // the driver stops the search at the hard limit either way
+    virtual void ponderhit([[maybe_unused]] const timeman::Allocation &allocation) noexcept {
+    }
+};
+
+// Plugs search::Search into the driver
+class SearchEngine : public Engine {
+   public:
+    [[nodiscard]] std::string name() const override {
+        return "libataxx";
+    }
+
+    [[nodiscard]] std::string author() const override {
+        return "kz04px";
+    }
+
+    [[nodiscard]] std::vector<Option> options() const override;
+
+    void set_option(const std::string &name, const std::string &value) override;
+
+    void new_game() override {
+        search_.clear();
+    }
+
+    [[nodiscard]] search::Result go(const Position &pos,
+                                    const search::Limits &limits,
+                                    const InfoHandler &info) override;
+
+    void stop() noexcept override {
+        search_.stop();
+    }
+
+    void ponderhit(const timeman::Allocation &allocation) noexcept override {
+        search_.ponderhit(allocation);
+    }
+
+   private:
+    search::Search search_;
+    int multipv_ = 1;
+};
+
+// Plugs mcts::MCTS into the driver, the tree under the moves played since the
+// last search is kept
+class MCTSEngine : public Engine {
+   public:
+    [[nodiscard]] std::string name() const override {
+        return "libataxx-mcts";
+    }
+
+    [[nodiscard]] std::string author() const override {
+        return "kz04px";
+    }
+
+    [[nodiscard]] std::vector<Option> options() const override;
+
+    void new_game() override {
+        mcts_.clear();
+    }
+
+    [[nodiscard]] search::Result go(const Position &pos,
+                                    const search::Limits &limits,
+                                    const InfoHandler &info) override;
+
+    void stop() noexcept override {
+        mcts_.stop();
+    }
+
+    void ponderhit(const timeman::Allocation &allocation) noexcept override {
+        mcts_.ponderhit(allocation);
+    }
+
+   private:
+    mcts::MCTS mcts_;
+};
+
+// Reads commands on the calling thread and searches on a thread of its own,
+// so "stop", "ponderhit" and "isready" are answered while a search runs
+class Driver {
+   public:
+    explicit Driver(Engine &engine, std::istream &in = std::cin, std::ostream &out = std::cout);
+
+    ~Driver();
+
+    Driver(const Driver &) = delete;
+
+    Driver &operator=(const Driver &) = delete;
+
+    // Handles commands until "quit" or the end of the input
+    void run();
+
+    // Returns false once "quit" is received
+    bool handle(const std::string &line);
+
+    // Blocks until the current search has printed its bestmove
+    void wait();
+
+    void set_time_manager(TimeManager time_manager) {
+        time_manager_ = std::move(time_manager);
+    }
+
+    [[nodiscard]] const Position &position() const noexcept {
+        return pos_;
+    }
+
+   private:
+    void send(const std::string &line);
+
+    void handle_position(const std::string &line);
+
+    void handle_go(const std::string &line);
+
+    void handle_stop();
+
+    void handle_ponderhit();
+
+    void search_thread();
+
+    void timer_thread();
+
+    Engine &engine_;
+    std::istream &in_;
+    std::ostream &out_;
+    std::mutex out_mtx_;
+    TimeManager time_manager_ = default_time_manager;
+    Position pos_{"startpos"};
+
+    // Shared with the search and timer threads
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool quit_ = false;
+    bool searching_ = false;
+    bool job_ready_ = false;
+    bool stop_requested_ = false;
+    // Pondering and infinite searches hold their bestmove until stop or ponderhit
+    bool hold_ = false;
+    bool pondering_ = false;
+    Position job_pos_;
+    search::Limits job_limits_;
+    GoParams job_params_;
+    timeman::Allocation allocation_;
+    std::optional<std::chrono::steady_clock::time_point> deadline_;
+    std::thread searcher_;
+    std::thread timer_;
+};
+
+}  // namespace libataxx::uai
+
+#endif
@@ -0,0 +1,235 @@
+#include "libataxx/mcts.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace libataxx::mcts {
+
+namespace {
+
+// Expected result for the side to move
+[[nodiscard]] float value(const Position &pos) noexcept {
+    if (pos.is_gameover()) {
+        const int score = search::terminal_score(pos, 0);
+        return score > 0 ? 1.0f : score < 0 ? 0.0f : 0.5f;
+    }
+    return 1.0f / (1.0f + std::exp(-search::evaluate(pos) / 400.0f));
+}
+
+[[nodiscard]] int to_score(const float q) noexcept {
+    const float clamped = std::clamp(q, 0.001f, 0.999f);
+    return static_cast<int>(-400.0f * std::log10(1.0f / clamped - 1.0f));
+}
+
+}  // namespace
+
+[[nodiscard]] search::Result MCTS::go(const Position &pos, const search::Limits &limits) {
+    // A ponderhit that comes in before the search starts still counts
+    stop_ = false;
+    if (!reuse(pos)) {
+        nodes_.clear();
+        nodes_.push_back(Node{});
+        reused_ = 0;
+    }
+    root_ = pos;
+
+    search::Result result;
+    if (pos.is_gameover()) {
+        ponderhit_ = false;
+        return result;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto movetime = limits.soft.count() > 0 ? limits.soft : limits.movetime;
+    std::uint64_t iterations = 0;
+
+    while (!stop_) {
+        iteration(pos);
+        iterations++;
+
+        if (limits.nodes > 0 && iterations >= limits.nodes) {
+            break;
+        }
+        if ((iterations & 63) == 0) {
+            if (ponderhit_.load(std::memory_order_acquire)) {
+                ponderhit_ = false;
+                start = std::chrono::steady_clock::now();
+                movetime = std::chrono::milliseconds(ponder_ms_);
+            }
+            if (movetime.count() > 0 && std::chrono::steady_clock::now() - start >= movetime) {
+                break;
+            }
+        }
+    }
+    ponderhit_ = false;
+
+    // Stopped before the first iteration expanded the root
+    if (nodes_[0].num_children == 0) {
+        Move moves[max_moves];
+        [[maybe_unused]] const int num_moves = pos.legal_moves(moves);
+        result.bestmove = moves[0];
+        result.pv = {moves[0]};
+        result.lines = {search::Line{moves[0], 0, 0, result.pv}};
+        result.nodes = iterations;
+        return result;
+    }
+
+    // Principal variation -- most visited children
+    const Node *node = &nodes_[0];
+    while (node->num_children > 0) {
+        node = &nodes_[most_visited(*node)];
+        if (node->visits == 0) {
+            break;
+        }
+        result.pv.push_back(node->move);
+    }
+
+    const auto &best = nodes_[most_visited(nodes_[0])];
+    result.bestmove = best.move;
+    result.score = best.visits > 0 ? to_score(best.total / best.visits) : 0;
+    result.depth = static_cast<int>(result.pv.size());
+    result.nodes = iterations;
+
+    // The most visited root moves, ties in the same order as most_visited()
+    const auto &root = nodes_[0];
+    std::vector<const Node *> children;
+    for (auto i = root.first_child; i < root.first_child + root.num_children; ++i) {
+        children.push_back(&nodes_[i]);
+    }
+    const auto num_lines = std::min<std::size_t>(std::max(1, limits.multipv), children.size());
+    std::partial_sort(children.begin(), children.begin() + num_lines, children.end(), [](auto a, auto b) {
+        return a->visits > b->visits || (a->visits == b->visits && a < b);
+    });
+    for (std::size_t i = 0; i < num_lines; ++i) {
+        const auto *child = children[i];
+        const int score = child->visits > 0 ? to_score(child->total / child->visits) : 0;
+        auto pv = i == 0 ? result.pv : std::vector<Move>{child->move};
+        result.lines.push_back(search::Line{child->move, score, result.depth, std::move(pv)});
+    }
+
+    return result;
+}
+
+[[nodiscard]] bool MCTS::reuse(const Position &pos) {
+    if (nodes_.empty() || !nodes_[0].expanded) {
+        return false;
+    }
+
+    // Look through the children and grandchildren of the old root
+    std::uint32_t found = 0;
+    if (root_.get_hash() == pos.get_hash()) {
+        found = 0;
+    } else {
+        const auto &root = nodes_[0];
+        for (auto i = root.first_child; i < root.first_child + root.num_children && !found; ++i) {
+            const auto child = root_.after_move(nodes_[i].move);
+            if (child.get_hash() == pos.get_hash()) {
+                found = i;
+                break;
+            }
+
+            const auto &node = nodes_[i];
+            for (auto j = node.first_child; j < node.first_child + node.num_children; ++j) {
+                if (child.after_move(nodes_[j].move).get_hash() == pos.get_hash()) {
+                    found = j;
+                    break;
+                }
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    // Copy the subtree to the front, children stay next to each other
+    std::vector<Node> tree;
+    tree.push_back(nodes_[found]);
+    tree[0].move = Move{};
+    for (std::size_t i = 0; i < tree.size(); ++i) {
+        const auto first = tree[i].first_child;
+        tree[i].first_child = static_cast<std::uint32_t>(tree.size());
+        for (std::uint32_t j = 0; j < tree[i].num_children; ++j) {
+            tree.push_back(nodes_[first + j]);
+        }
+    }
+
+    nodes_ = std::move(tree);
+    reused_ = nodes_[0].visits;
+    return true;
+}
+
+void MCTS::iteration(const Position &root) {
+    auto pos = root;
+    std::uint32_t idx = 0;
+    path_.clear();
+    path_.push_back(idx);
+
+    // Selection
+    while (nodes_[idx].expanded && nodes_[idx].num_children > 0) {
+        idx = select(nodes_[idx]);
+        pos.makemove(nodes_[idx].move);
+        path_.push_back(idx);
+    }
+
+    // Expansion, a leaf left unexpanded in a full tree is still evaluated
+    if (pos.is_gameover()) {
+        nodes_[idx].expanded = true;
+    } else if (!nodes_[idx].expanded) {
+        Move moves[max_moves];
+        const int num_moves = pos.legal_moves(moves);
+        const auto first = static_cast<std::uint32_t>(nodes_.size());
+        if (static_cast<std::uint32_t>(num_moves) <= max_nodes_ - first) {
+            for (int i = 0; i < num_moves; ++i) {
+                Node child;
+                child.move = moves[i];
+                nodes_.push_back(child);
+            }
+            nodes_[idx].first_child = first;
+            nodes_[idx].num_children = num_moves;
+            nodes_[idx].expanded = true;
+        }
+    }
+
+    // Backpropagation
+    float v = 1.0f - value(pos);
+    for (auto it = path_.rbegin(); it != path_.rend(); ++it) {
+        nodes_[*it].visits++;
+        nodes_[*it].total += v;
+        v = 1.0f - v;
+    }
+}
+
+[[nodiscard]] std::uint32_t MCTS::select(const Node &parent) const noexcept {
+    const float log_visits = std::log(static_cast<float>(parent.visits));
+    std::uint32_t best = parent.first_child;
+    float best_uct = -std::numeric_limits<float>::infinity();
+
+    for (std::uint32_t i = parent.first_child; i < parent.first_child + parent.num_children; ++i) {
+        const auto &child = nodes_[i];
+        if (child.visits == 0) {
+            return i;
+        }
+        const float uct = child.total / child.visits + exploration_ * std::sqrt(log_visits / child.visits);
+        if (uct > best_uct) {
+            best_uct = uct;
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+[[nodiscard]] std::uint32_t MCTS::most_visited(const Node &parent) const noexcept {
+    std::uint32_t best = parent.first_child;
+    for (std::uint32_t i = parent.first_child; i < parent.first_child + parent.num_children; ++i) {
+        if (nodes_[i].visits > nodes_[best].visits) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+}  // namespace libataxx::mcts
@@ -0,0 +1,114 @@
+#include "libataxx/movepicker.hpp"
+#include <array>
+#include <utility>
+#include "libataxx/lookup.hpp"
+
+namespace libataxx::search {
+
+[[nodiscard]] Move MovePicker::next() noexcept {
+    switch (stage_) {
+        case Stage::TTMove:
+            stage_ = Stage::GenerateCaptures;
+            if (tt_move_ != Move::nomove() && pos_.is_legal_move(tt_move_)) {
+                return tt_move_;
+            }
+            tt_move_ = Move::nomove();
+            [[fallthrough]];
+        case Stage::GenerateCaptures:
+            size_ = pos_.legal_captures(moves_);
+            index_ = 0;
+            score_captures();
+            stage_ = Stage::Captures;
+            [[fallthrough]];
+        case Stage::Captures:
+            if (const auto move = pick_best(); move != Move::nomove()) {
+                return move;
+            }
+            stage_ = Stage::GenerateQuiets;
+            [[fallthrough]];
+        case Stage::GenerateQuiets:
+            // Includes the nullmove when there's nothing else
+            size_ = pos_.legal_noncaptures(moves_);
+            index_ = 0;
+            score_quiets();
+            stage_ = Stage::Quiets;
+            [[fallthrough]];
+        case Stage::Quiets:
+            if (const auto move = pick_best(); move != Move::nomove()) {
+                return move;
+            }
+            stage_ = Stage::Done;
+            [[fallthrough]];
+        default:
+            return Move::nomove();
+    }
+}
+
+void MovePicker::score_captures() noexcept {
+    // Stones flipped by landing on each square next to theirs, shared by all
+    // the moves that land there
+    const auto them = pos_.get_them();
+    std::uint8_t flips[64];
+    for (const auto &sq : them.singles() & pos_.get_empty()) {
+        flips[static_cast<int>(sq)] = (lut::get_singles(sq) & them).count();
+    }
+
+    for (int i = 0; i < size_; ++i) {
+        const auto &move = moves_[i];
+        scores_[i] = 2 * flips[static_cast<int>(move.to())] + move.is_single();
+    }
+}
+
+void MovePicker::score_quiets() noexcept {
+    const auto side = pos_.get_turn();
+    auto killers = std::array<Move, num_killers>{};
+    auto counter = Move::nomove();
+    if (histories_) {
+        killers = histories_->killers.get(ply_);
+        counter = histories_->counters.get(side, prev_);
+    }
+
+    for (int i = 0; i < size_; ++i) {
+        const auto &move = moves_[i];
+        if (move == Move::nullmove()) {
+            scores_[i] = 0;
+            continue;
+        }
+
+        if (move == killers[0]) {
+            scores_[i] = 1 << 22;
+        } else if (move == killers[1]) {
+            scores_[i] = 1 << 21;
+        } else if (move == counter) {
+            scores_[i] = 1 << 20;
+        } else {
+            // History sums stay within +-2 * max_history
+            int score = (move.is_single() ? 1 << 18 : 0) + 2 * max_history;
+            if (histories_) {
+                score += histories_->butterfly.get(side, move) + histories_->continuation.get(prev_, move);
+            }
+            scores_[i] = score;
+        }
+    }
+}
+
+[[nodiscard]] Move MovePicker::pick_best() noexcept {
+    while (index_ < size_) {
+        int best = index_;
+        for (int i = index_ + 1; i < size_; ++i) {
+            if (scores_[i] > scores_[best]) {
+                best = i;
+            }
+        }
+        std::swap(moves_[index_], moves_[best]);
+        std::swap(scores_[index_], scores_[best]);
+
+        const auto move = moves_[index_++];
+        if (move != tt_move_) {
+            return move;
+        }
+    }
+    return Move::nomove();
+}
+
+}  // namespace libataxx::search
@@ -1,8 +1,104 @@
+#include <algorithm>
+#include "libataxx/lookup.hpp"
 #include "libataxx/move.hpp"
 #include "libataxx/position.hpp"
 
 namespace libataxx {
 
+namespace {
+
+// Adds the moves from a position that isn't over to the stats without making
+// any of them, children that end the game are found from the bitboards:
+// - a move next to every enemy stone flips all of them
+// - a single onto the only empty square anyone can reach leaves no moves
+//   unless the new stone reaches empty squares nobody could before, a double
+//   always leaves its own square behind
+// - doubles and passes run the halfmove clock out at 99
+void count_moves(const Position &pos, PerftStats &stats) noexcept {
+    const auto us = pos.get_us();
+    const auto them = pos.get_them();
+    const auto empty = pos.get_empty();
+    const bool black = pos.get_turn() == Side::Black;
+    const bool clock_expires = pos.get_halfmoves() + 1 >= 100;
+
+    // Score is from the point of view of the side making the move
+    const auto add_gameover = [&](const int score) {
+        stats.gameovers++;
+        if (score == 0) {
+            stats.draws++;
+        } else if ((score > 0) == black) {
+            stats.black_wins++;
+        } else {
+            stats.white_wins++;
+        }
+    };
+
+    if (pos.must_pass()) {
+        stats.nodes++;
+        stats.passes++;
+        if (clock_expires) {
+            add_gameover(0);
+        }
+        return;
+    }
+
+    auto wipeout = Bitboard{Bitmask::All};
+    for (const auto &sq : them) {
+        wipeout &= lut::get_singles(sq);
+    }
+    const auto reachable = pos.get_both().singles().singles() & empty;
+    const bool last_square = reachable.count() == 1;
+    const int num_us = us.count();
+    const int num_them = them.count();
+    const auto before = stats.singles + stats.doubles;
+
+    for (const auto &to : us.singles() & empty) {
+        const int flips = (lut::get_singles(to) & them).count();
+        stats.singles++;
+        stats.captures += flips > 0;
+        stats.flips += flips;
+        const bool blocked = last_square && !((lut::get_singles(to) | lut::get_doubles(to)) & empty);
+        if (blocked || (wipeout & Bitboard{to})) {
+            add_gameover(num_us + 1 + 2 * flips - num_them);
+        }
+    }
+
+    for (const auto &from : us) {
+        for (const auto &to : lut::get_doubles(from) & empty) {
+            const int flips = (lut::get_singles(to) & them).count();
+            stats.doubles++;
+            stats.captures += flips > 0;
+            stats.flips += flips;
+            if (wipeout & Bitboard{to}) {
+                add_gameover(num_us + 2 * flips - num_them);
+            } else if (clock_expires) {
+                add_gameover(0);
+            }
+        }
+    }
+
+    stats.nodes += stats.singles + stats.doubles - before;
+}
+
+void perft_stats(const Position &pos, const int depth, PerftStats *stats) noexcept {
+    if (pos.is_gameover()) {
+        return;
+    }
+
+    count_moves(pos, *stats);
+    if (depth == 1) {
+        return;
+    }
+
+    Move moves[max_moves];
+    const int num_moves = pos.legal_moves(moves);
+    for (int i = 0; i < num_moves; ++i) {
+        perft_stats(pos.after_move<false>(moves[i]), depth - 1, stats + 1);
+    }
+}
+
+}  // namespace
+
 [[nodiscard]] std::uint64_t Position::perft(const int depth) const noexcept {
     if (depth == 1) {
         return count_legal_moves();
@@ -23,4 +119,12 @@ namespace libataxx {
     return nodes;
 }
 
+[[nodiscard]] std::vector<PerftStats> Position::perft_stats(const int depth) const {
+    std::vector<PerftStats> stats(std::max(0, depth));
+    if (depth > 0) {
+        libataxx::perft_stats(*this, depth, stats.data());
+    }
+    return stats;
+}
+
 }  // namespace libataxx
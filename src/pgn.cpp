@@ -0,0 +1,164 @@
+#include "libataxx/pgn.hpp"
+#include <cctype>
+#include <stdexcept>
+
+namespace libataxx::pgn {
+
+namespace {
+
+[[nodiscard]] bool is_result(const std::string &token) noexcept {
+    return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+[[nodiscard]] bool is_delimiter(const int c) noexcept {
+    return std::isspace(c) || c == '{' || c == '}' || c == '(' || c == ')' || c == '[' || c == ';';
+}
+
+[[nodiscard]] std::string trim(const std::string &str) {
+    const auto first = str.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    const auto last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
+
+void read_header(std::istream &is, Header &header) {
+    std::string line;
+    std::getline(is, line, ']');
+
+    // [Key "Value"]
+    const auto key_start = line.find_first_not_of("[ \t");
+    const auto key_end = line.find_first_of(" \t", key_start);
+    const auto value_start = line.find('"', key_end);
+    const auto value_end = line.rfind('"');
+    if (key_start == std::string::npos || key_end == std::string::npos || value_start == std::string::npos ||
+        value_end == value_start) {
+        throw std::invalid_argument("Invalid PGN header (" + line + ")");
+    }
+
+    header.add(line.substr(key_start, key_end - key_start), line.substr(value_start + 1, value_end - value_start - 1));
+}
+
+}  // namespace
+
+[[nodiscard]] std::optional<PGN> read(std::istream &is) {
+    PGN pgn;
+    Node *current = pgn.root();
+    std::vector<Node *> stack;
+    bool found = false;
+    bool in_moves = false;
+    bool variation_start = false;
+
+    const auto start_moves = [&]() {
+        if (!in_moves && start_position(pgn).get_turn() == Side::White) {
+            pgn.set_black_first(false);
+        }
+        found = true;
+        in_moves = true;
+    };
+
+    for (int c = is.peek(); c != std::char_traits<char>::eof(); c = is.peek()) {
+        if (std::isspace(c)) {
+            is.get();
+        } else if (c == '[') {
+            // The next game's headers
+            if (in_moves) {
+                break;
+            }
+            read_header(is, pgn.header());
+            found = true;
+        } else if (c == '{') {
+            is.get();
+            std::string comment;
+            std::getline(is, comment, '}');
+            start_moves();
+            current->add_comment(trim(comment));
+        } else if (c == ';') {
+            std::string comment;
+            std::getline(is, comment);
+        } else if (c == '(') {
+            is.get();
+            start_moves();
+            stack.push_back(current);
+            variation_start = true;
+        } else if (c == ')') {
+            is.get();
+            if (stack.empty()) {
+                throw std::invalid_argument("Unexpected ')' in PGN");
+            }
+            current = stack.back();
+            stack.pop_back();
+            variation_start = false;
+        } else {
+            std::string token;
+            while (is.peek() != std::char_traits<char>::eof() && !is_delimiter(is.peek())) {
+                token += static_cast<char>(is.get());
+            }
+
+            if (token.empty()) {
+                throw std::invalid_argument(std::string("Unexpected '") + static_cast<char>(c) + "' in PGN");
+            }
+
+            start_moves();
+
+            if (is_result(token)) {
+                break;
+            }
+
+            // NAGs
+            if (token[0] == '$') {
+                continue;
+            }
+
+            // Move numbers, either "12." or "12..." and possibly joined to the move
+            const auto digits = token.find_first_not_of("0123456789");
+            if (digits != std::string::npos && digits > 0 && token[digits] == '.') {
+                const auto rest = token.find_first_not_of('.', digits);
+                token = rest == std::string::npos ? "" : token.substr(rest);
+            }
+            if (token.empty()) {
+                continue;
+            }
+
+            // Annotations
+            while (!token.empty() && (token.back() == '!' || token.back() == '?')) {
+                token.pop_back();
+            }
+
+            const auto move = Move::from_uai(token);
+            if (variation_start) {
+                current = stack.back()->add_variation(move);
+                variation_start = false;
+            } else {
+                current = current->add_mainline(move);
+            }
+        }
+    }
+
+    if (!found) {
+        return std::nullopt;
+    }
+
+    return pgn;
+}
+
+[[nodiscard]] Position start_position(const PGN &pgn) noexcept {
+    return Position{pgn.header().get("FEN").value_or("startpos")};
+}
+
+[[nodiscard]] Result get_result(const PGN &pgn) noexcept {
+    const auto result = pgn.header().get("Result").value_or("*");
+    if (result == "1-0") {
+        return Result::WhiteWin;
+    }
+    if (result == "0-1") {
+        return Result::BlackWin;
+    }
+    if (result == "1/2-1/2") {
+        return Result::Draw;
+    }
+    return Result::None;
+}
+
+}  // namespace libataxx::pgn
@@ -0,0 +1,340 @@
+#include "libataxx/position_set.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include "libataxx/symmetry.hpp"
+
+namespace libataxx {
+
+namespace {
+
+constexpr std::uint64_t empty_slot = 0;
+constexpr std::size_t initial_table_size = 1024;
+// Keys read or written at a time when merging spilled files
+constexpr std::size_t io_keys = 1 << 16;
+
+// Different bits of the key pick the shard, the table slot and the bloom bits
+[[nodiscard]] std::uint64_t bloom_hash(const std::uint64_t key, const int i) noexcept {
+    return (key ^ (key >> 29)) * (0x9e3779b97f4a7c15ULL + 2 * i);
+}
+
+// Carries on after short writes and writes cut short by a signal
+void write_keys(const int fd, const std::uint64_t *keys, const std::size_t count, const std::string &path) {
+    auto ptr = reinterpret_cast<const char *>(keys);
+    auto left = count * sizeof(std::uint64_t);
+    while (left > 0) {
+        const auto n = ::write(fd, ptr, left);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::runtime_error("PositionSet: could not write " + path);
+        }
+        ptr += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+void read_keys(const int fd,
+               std::uint64_t *keys,
+               const std::size_t count,
+               const std::uint64_t first,
+               const std::string &path) {
+    auto ptr = reinterpret_cast<char *>(keys);
+    auto left = count * sizeof(std::uint64_t);
+    auto offset = static_cast<off_t>(first * sizeof(std::uint64_t));
+    while (left > 0) {
+        const auto n = ::pread(fd, ptr, left, offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::runtime_error("PositionSet: could not read " + path);
+        }
+        ptr += n;
+        offset += n;
+        left -= static_cast<std::size_t>(n);
+    }
+}
+
+void remove_file(const int fd, const std::string &path) noexcept {
+    ::close(fd);
+    std::remove(path.c_str());
+}
+
+// The keys of a spilled file in order, a block at a time
+class RunReader {
+   public:
+    RunReader(const int fd, const std::uint64_t size, const std::string &path) : fd_{fd}, size_{size}, path_{path} {
+        refill();
+    }
+
+    [[nodiscard]] bool done() const noexcept {
+        return pos_ == buffer_.size();
+    }
+
+    [[nodiscard]] std::uint64_t peek() const noexcept {
+        return buffer_[pos_];
+    }
+
+    void next() {
+        if (++pos_ == buffer_.size()) {
+            refill();
+        }
+    }
+
+   private:
+    void refill() {
+        const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(io_keys, size_ - read_));
+        buffer_.resize(count);
+        read_keys(fd_, buffer_.data(), count, read_, path_);
+        read_ += count;
+        pos_ = 0;
+    }
+
+    int fd_;
+    std::uint64_t size_;
+    const std::string &path_;
+    std::vector<std::uint64_t> buffer_;
+    std::size_t pos_ = 0;
+    std::uint64_t read_ = 0;
+};
+
+}  // namespace
+
+PositionSet::PositionSet(const PositionSetOptions &options) : options_{options} {
+    num_shards_ = 2;
+    while (num_shards_ < options_.shards) {
+        num_shards_ *= 2;
+    }
+    shard_shift_ = 64 - __builtin_ctzll(num_shards_);
+
+    shards_ = std::make_unique<Shard[]>(num_shards_);
+    for (std::size_t i = 0; i < num_shards_; ++i) {
+        shards_[i].table.assign(initial_table_size, empty_slot);
+    }
+
+    if (options_.bloom) {
+        bloom_words_ = std::max<std::size_t>(1, options_.bloom_bits / 64);
+        bloom_ = std::make_unique<std::atomic<std::uint64_t>[]>(bloom_words_);
+        for (std::size_t i = 0; i < bloom_words_; ++i) {
+            bloom_[i] = 0;
+        }
+    }
+}
+
+PositionSet::~PositionSet() {
+    for (std::size_t i = 0; i < num_shards_; ++i) {
+        for (const auto &run : shards_[i].runs) {
+            remove_file(run.fd, run.path);
+        }
+    }
+}
+
+[[nodiscard]] std::uint64_t PositionSet::key(const Position &pos) noexcept {
+    return canonical_hash(pos);
+}
+
+bool PositionSet::insert_key(std::uint64_t key) {
+    // Zero marks an empty slot
+    key = key == empty_slot ? 1 : key;
+
+    auto &s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mtx);
+
+    // A key that fails the bloom filter has never been inserted before
+    // This has to happen under the shard's lock so two threads inserting the
+    // same key can't both see it as new
+    const bool maybe_seen = !options_.bloom || bloom_test_and_set(key);
+
+    if (maybe_seen && (in_memory(s, key) || in_runs(s, key))) {
+        return false;
+    }
+
+    add_to_memory(s, key);
+    size_++;
+
+    if (options_.max_memory_keys > 0 && s.count >= std::max<std::size_t>(1, options_.max_memory_keys / num_shards_)) {
+        spill(s, &s - shards_.get());
+    }
+
+    return true;
+}
+
+[[nodiscard]] bool PositionSet::contains_key(std::uint64_t key) const {
+    key = key == empty_slot ? 1 : key;
+
+    if (options_.bloom && !bloom_test(key)) {
+        return false;
+    }
+
+    const auto &s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mtx);
+    return in_memory(s, key) || in_runs(s, key);
+}
+
+[[nodiscard]] bool PositionSet::bloom_test_and_set(const std::uint64_t key) noexcept {
+    bool seen = true;
+    for (int i = 0; i < 3; ++i) {
+        const auto bit = bloom_hash(key, i) % (64 * bloom_words_);
+        const auto mask = 1ULL << (bit % 64);
+        const auto old = bloom_[bit / 64].fetch_or(mask, std::memory_order_relaxed);
+        seen &= (old & mask) != 0;
+    }
+    return seen;
+}
+
+[[nodiscard]] bool PositionSet::bloom_test(const std::uint64_t key) const noexcept {
+    for (int i = 0; i < 3; ++i) {
+        const auto bit = bloom_hash(key, i) % (64 * bloom_words_);
+        if (!(bloom_[bit / 64].load(std::memory_order_relaxed) & (1ULL << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+[[nodiscard]] bool PositionSet::in_memory(const Shard &s, const std::uint64_t key) const noexcept {
+    const auto mask = s.table.size() - 1;
+    for (auto idx = key & mask;; idx = (idx + 1) & mask) {
+        if (s.table[idx] == key) {
+            return true;
+        }
+        if (s.table[idx] == empty_slot) {
+            return false;
+        }
+    }
+}
+
+[[nodiscard]] bool PositionSet::in_runs(const Shard &s, const std::uint64_t key) const {
+    for (const auto &run : s.runs) {
+        // Binary search the sorted keys on disk
+        std::uint64_t lo = 0;
+        std::uint64_t hi = run.size;
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2;
+            std::uint64_t value = 0;
+            read_keys(run.fd, &value, 1, mid, run.path);
+            if (value == key) {
+                return true;
+            }
+            if (value < key) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+    return false;
+}
+
+void PositionSet::add_to_memory(Shard &s, const std::uint64_t key) {
+    // Keep the load factor below one half
+    if (2 * (s.count + 1) > s.table.size()) {
+        std::vector<std::uint64_t> old(2 * s.table.size(), empty_slot);
+        std::swap(old, s.table);
+        s.count = 0;
+        for (const auto k : old) {
+            if (k != empty_slot) {
+                add_to_memory(s, k);
+            }
+        }
+    }
+
+    const auto mask = s.table.size() - 1;
+    auto idx = key & mask;
+    while (s.table[idx] != empty_slot) {
+        idx = (idx + 1) & mask;
+    }
+    s.table[idx] = key;
+    s.count++;
+}
+
+void PositionSet::spill(Shard &s, const std::size_t idx) {
+    std::vector<std::uint64_t> keys;
+    keys.reserve(s.count);
+    for (const auto k : s.table) {
+        if (k != empty_slot) {
+            keys.push_back(k);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto run = create_run(s, idx);
+    try {
+        write_keys(run.fd, keys.data(), keys.size(), run.path);
+    } catch (...) {
+        remove_file(run.fd, run.path);
+        throw;
+    }
+    run.size = keys.size();
+
+    s.runs.push_back(run);
+    std::fill(s.table.begin(), s.table.end(), empty_slot);
+    s.count = 0;
+    spilled_ += keys.size();
+
+    // Every lookup searches every file, so fold the newest file into the one
+    // before it while that one is no larger or there are too many
+    while (s.runs.size() >= 2) {
+        const auto &older = s.runs[s.runs.size() - 2];
+        const auto &newer = s.runs.back();
+        if (s.runs.size() <= std::max<std::size_t>(1, options_.max_runs) && older.size > newer.size) {
+            break;
+        }
+
+        const auto merged = merge_runs(s, idx, older, newer);
+        remove_file(older.fd, older.path);
+        remove_file(newer.fd, newer.path);
+        s.runs.pop_back();
+        s.runs.back() = merged;
+    }
+}
+
+[[nodiscard]] PositionSet::Run PositionSet::create_run(Shard &s, const std::size_t idx) const {
+    Run run;
+    run.path = options_.spill_directory + "/positionset-" + std::to_string(::getpid()) + "-" +
+               std::to_string(reinterpret_cast<std::uintptr_t>(this)) + "-" + std::to_string(idx) + "-" +
+               std::to_string(s.next_run++) + ".bin";
+    run.fd = ::open(run.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (run.fd < 0) {
+        throw std::runtime_error("PositionSet: could not create " + run.path);
+    }
+    return run;
+}
+
+// No key is in more than one file, so there's nothing to drop
+[[nodiscard]] PositionSet::Run PositionSet::merge_runs(Shard &s,
+                                                       const std::size_t idx,
+                                                       const Run &a,
+                                                       const Run &b) const {
+    auto run = create_run(s, idx);
+    try {
+        RunReader ra{a.fd, a.size, a.path};
+        RunReader rb{b.fd, b.size, b.path};
+        std::vector<std::uint64_t> buffer;
+        buffer.reserve(io_keys);
+
+        while (!ra.done() || !rb.done()) {
+            auto &from = rb.done() || (!ra.done() && ra.peek() < rb.peek()) ? ra : rb;
+            buffer.push_back(from.peek());
+            from.next();
+            if (buffer.size() == io_keys) {
+                write_keys(run.fd, buffer.data(), buffer.size(), run.path);
+                buffer.clear();
+            }
+        }
+        write_keys(run.fd, buffer.data(), buffer.size(), run.path);
+    } catch (...) {
+        remove_file(run.fd, run.path);
+        throw;
+    }
+
+    run.size = a.size + b.size;
+    return run;
+}
+
+}  // namespace libataxx
@@ -0,0 +1,395 @@
+#include "libataxx/search.hpp"
+#include <algorithm>
+#include <cmath>
+#include "libataxx/movepicker.hpp"
+
+namespace libataxx::search {
+
+namespace {
+
+[[nodiscard]] int score_to_tt(const int score, const int ply) noexcept {
+    if (score > mate_bound) {
+        return score + ply;
+    }
+    if (score < -mate_bound) {
+        return score - ply;
+    }
+    return score;
+}
+
+[[nodiscard]] int score_from_tt(const int score, const int ply) noexcept {
+    if (score > mate_bound) {
+        return score - ply;
+    }
+    if (score < -mate_bound) {
+        return score + ply;
+    }
+    return score;
+}
+
+}  // namespace
+
+bool set_param(Params &params, const std::string &name, const int value) noexcept {
+    for (const auto &info : param_info) {
+        if (name == info.name) {
+            params.*info.value = std::clamp(value, info.min, info.max);
+            return true;
+        }
+    }
+    return false;
+}
+
+[[nodiscard]] Params no_pruning() noexcept {
+    Params params;
+    params.nmp_depth = 0;
+    params.lmr_depth = 0;
+    params.futility_depth = 0;
+    params.rfp_depth = 0;
+    params.razor_depth = 0;
+    return params;
+}
+
+Search::Search(const std::size_t tt_mb) : histories_{std::make_unique<Histories>()} {
+    resize(tt_mb);
+    set_params(Params{});
+}
+
+void Search::set_params(const Params &params) noexcept {
+    params_ = params;
+    for (int depth = 1; depth < lmr_size; ++depth) {
+        for (int moves = 1; moves < lmr_size; ++moves) {
+            const double r = params.lmr_base / 100.0 + std::log(depth) * std::log(moves) * 100.0 / params.lmr_divisor;
+            lmr_[depth][moves] = static_cast<int>(r);
+        }
+    }
+}
+
+void Search::clear() noexcept {
+    std::fill(tt_.begin(), tt_.end(), TTEntry{});
+    histories_->clear();
+}
+
+void Search::resize(const std::size_t tt_mb) {
+    const auto num_entries = std::max<std::size_t>(1, tt_mb * 1024 * 1024 / sizeof(TTEntry));
+    tt_.assign(num_entries, TTEntry{});
+}
+
+[[nodiscard]] Result Search::go(const Position &pos, const Limits &limits) {
+    // A ponderhit that comes in before the search starts still counts, the
+    // flag is cleared once the search is over instead
+    stop_ = false;
+    limits_ = limits;
+    nodes_ = 0;
+    start_ = std::chrono::steady_clock::now();
+    tm_ = timeman::TimeManager{timeman::Allocation{limits.soft, limits.movetime}};
+    tm_.start();
+    histories_->killers.clear();
+    verifying_ = false;
+
+    Result result;
+    if (pos.is_gameover()) {
+        ponderhit_ = false;
+        return result;
+    }
+
+    const int max_depth = limits.depth > 0 ? std::min(limits.depth, max_ply - 1) : max_ply - 1;
+    const int num_lines = std::clamp(limits.multipv, 1, pos.count_legal_moves());
+
+    for (int depth = 1; depth <= max_depth; ++depth) {
+        // Each line is the best move left once the ones before it are excluded
+        std::vector<Line> lines;
+        excluded_.clear();
+
+        for (int i = 0; i < num_lines; ++i) {
+            const int score = alphabeta(pos, -mate_score, mate_score, depth, 0);
+
+            // Results from an unfinished search can't be trusted
+            if ((stop_ && (result.bestmove != Move::nomove() || i > 0)) || pv_length_[0] == 0) {
+                break;
+            }
+
+            lines.push_back(Line{pv_[0][0], score, depth, get_pv()});
+            excluded_.push_back(pv_[0][0]);
+
+            if (info_handler_) {
+                const auto elapsed = std::chrono::steady_clock::now() - start_;
+                info_handler_(Info{depth,
+                                   score,
+                                   nodes_,
+                                   std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+                                   lines.back().pv,
+                                   num_lines > 1 ? i + 1 : 0});
+            }
+
+            if (stop_) {
+                break;
+            }
+        }
+
+        // Lines from this iteration first, then any left over from the last
+        for (const auto &line : result.lines) {
+            const auto same = [&line](const Line &other) { return other.move == line.move; };
+            if (static_cast<int>(lines.size()) < num_lines && std::none_of(lines.begin(), lines.end(), same)) {
+                lines.push_back(line);
+            }
+        }
+
+        if (!lines.empty()) {
+            result.lines = lines;
+            result.bestmove = lines.front().move;
+            result.score = lines.front().score;
+            result.depth = lines.front().depth;
+            result.pv = lines.front().pv;
+        }
+
+        if (stop_) {
+            break;
+        }
+
+        tm_.update(depth, result.bestmove, result.score);
+        if (!tm_.should_continue()) {
+            break;
+        }
+    }
+
+    // Stopped before a single move was searched
+    if (result.bestmove == Move::nomove()) {
+        Move moves[max_moves];
+        [[maybe_unused]] const int num_moves = pos.legal_moves(moves);
+        result.bestmove = moves[0];
+        result.pv = {moves[0]};
+        result.lines = {Line{moves[0], 0, 0, result.pv}};
+    }
+
+    result.nodes = nodes_;
+    ponderhit_ = false;
+    return result;
+}
+
+[[nodiscard]] bool Search::should_stop() noexcept {
+    if (limits_.nodes > 0 && nodes_ >= limits_.nodes) {
+        return true;
+    }
+    if (ponderhit_.load(std::memory_order_acquire)) {
+        ponderhit_ = false;
+        const auto soft = std::chrono::milliseconds(ponder_soft_);
+        const auto hard = std::chrono::milliseconds(ponder_hard_);
+        tm_.restart(timeman::Allocation{soft, hard});
+    }
+    return tm_.should_stop(nodes_);
+}
+
+[[nodiscard]] std::vector<Move> Search::get_pv() const {
+    return std::vector<Move>(pv_[0], pv_[0] + pv_length_[0]);
+}
+
+[[nodiscard]] int Search::alphabeta(const Position &pos, int alpha, int beta, int depth, const int ply) {
+    pv_length_[ply] = 0;
+    nodes_++;
+
+    if (should_stop()) {
+        stop_ = true;
+    }
+
+    if (stop_) {
+        return 0;
+    }
+
+    if (pos.is_gameover()) {
+        return terminal_score(pos, ply);
+    }
+
+    if (depth <= 0 || ply >= max_ply - 1) {
+        return evaluate(pos);
+    }
+
+    // Poll TT
+    const auto hash = pos.get_hash();
+    auto &entry = tt_entry(hash);
+    auto tt_move = Move::nomove();
+    if (entry.hash == hash) {
+        tt_move = entry.move;
+
+        if (ply > 0 && entry.depth >= depth) {
+            const int score = score_from_tt(entry.score, ply);
+            if (entry.bound == Bound::Exact || (entry.bound == Bound::Lower && score >= beta) ||
+                (entry.bound == Bound::Upper && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    const bool pv_node = beta - alpha > 1;
+    const int eval = evaluate(pos);
+    const auto prev = ply > 0 ? stack_[ply - 1] : Move::nomove();
+
+    if (!pv_node && ply > 0 && std::abs(beta) < mate_bound) {
+        // Reverse futility pruning
+        if (depth <= params_.rfp_depth && eval - params_.rfp_margin * depth >= beta) {
+            return eval;
+        }
+
+        // Null move pruning -- passing is only legal when there's no move, so
+        // two in a row or one with no move to compare against proves nothing
+        if (depth >= params_.nmp_depth && params_.nmp_depth > 0 && !verifying_ && eval >= beta &&
+            prev != Move::nullmove() && !pos.must_pass() && pos.get_empty().count() >= params_.nmp_min_empty) {
+            const int reduced = depth - 1 - params_.nmp_reduction - depth / 4;
+            stack_[ply] = Move::nullmove();
+            int score = -alphabeta(pos.after_move(Move::nullmove()), -beta, -beta + 1, reduced, ply + 1);
+
+            if (stop_) {
+                return 0;
+            }
+
+            if (score >= beta) {
+                score = std::min(score, mate_bound);
+                if (depth < params_.nmp_verify_depth || params_.nmp_verify_depth == 0) {
+                    return score;
+                }
+
+                // Positions where every move is bad also pass the null move
+                verifying_ = true;
+                const int verified = alphabeta(pos, beta - 1, beta, reduced, ply);
+                verifying_ = false;
+
+                if (stop_) {
+                    return 0;
+                }
+                if (verified >= beta) {
+                    return score;
+                }
+            }
+        }
+
+        // Razoring
+        if (depth <= params_.razor_depth && eval + params_.razor_margin * depth <= alpha) {
+            depth--;
+            if (depth == 0) {
+                return eval;
+            }
+        }
+    }
+
+    const int alpha_orig = alpha;
+    int best_score = -mate_score;
+    auto best_move = Move::nomove();
+    Move quiets[max_moves];
+    int num_quiets = 0;
+    int moves_searched = 0;
+
+    // Quiet singles gain one stone and quiet doubles none
+    const bool futile = !pv_node && ply > 0 && depth <= params_.futility_depth && alpha > -mate_bound &&
+                        eval + 100 + params_.futility_margin * depth <= alpha;
+
+    // Moves come out best first, later stages aren't generated after a cutoff
+    MovePicker picker{pos, tt_move, histories_.get(), prev, ply};
+    for (auto move = picker.next(); move != Move::nomove(); move = picker.next()) {
+        if (ply == 0 && std::find(excluded_.begin(), excluded_.end(), move) != excluded_.end()) {
+            continue;
+        }
+
+        const int captures = move == Move::nullmove() ? 0 : pos.count_captures(move);
+        const bool quiet = move != Move::nullmove() && captures == 0;
+
+        if (futile && quiet && moves_searched > 0) {
+            continue;
+        }
+
+        stack_[ply] = move;
+        const auto npos = pos.after_move(move);
+        int score = 0;
+
+        if (moves_searched == 0) {
+            score = -alphabeta(npos, -beta, -alpha, depth - 1, ply + 1);
+        } else {
+            // Late move reductions, big captures are reduced less
+            int reduction = 0;
+            if (depth >= params_.lmr_depth && params_.lmr_depth > 0 && moves_searched >= params_.lmr_moves) {
+                reduction = lmr_[std::min(depth, lmr_size - 1)][std::min(moves_searched, lmr_size - 1)];
+                reduction -= captures + pv_node;
+                reduction = std::clamp(reduction, 0, std::max(0, depth - 2));
+            }
+
+            score = -alphabeta(npos, -alpha - 1, -alpha, depth - 1 - reduction, ply + 1);
+            if (score > alpha && reduction > 0) {
+                score = -alphabeta(npos, -alpha - 1, -alpha, depth - 1, ply + 1);
+            }
+            if (score > alpha && score < beta) {
+                score = -alphabeta(npos, -beta, -alpha, depth - 1, ply + 1);
+            }
+        }
+        moves_searched++;
+
+        if (stop_) {
+            return 0;
+        }
+
+        if (score > best_score) {
+            best_score = score;
+            best_move = move;
+        }
+
+        if (score > alpha) {
+            alpha = score;
+
+            // Update PV
+            pv_[ply][0] = move;
+            std::copy(pv_[ply + 1], pv_[ply + 1] + pv_length_[ply + 1], pv_[ply] + 1);
+            pv_length_[ply] = pv_length_[ply + 1] + 1;
+
+            if (alpha >= beta) {
+                if (quiet) {
+                    update_histories(pos, move, quiets, num_quiets, depth, ply);
+                }
+                break;
+            }
+        }
+
+        if (quiet) {
+            quiets[num_quiets++] = move;
+        }
+    }
+
+    // The root's best move with some excluded isn't its best move
+    if (ply == 0 && !excluded_.empty()) {
+        return best_score;
+    }
+
+    // Create TT entry
+    auto bound = Bound::Exact;
+    if (best_score <= alpha_orig) {
+        bound = Bound::Upper;
+    } else if (best_score >= beta) {
+        bound = Bound::Lower;
+    }
+    entry = TTEntry{hash,
+                    best_move,
+                    static_cast<std::int16_t>(score_to_tt(best_score, ply)),
+                    static_cast<std::int8_t>(depth),
+                    bound};
+
+    return best_score;
+}
+
+void Search::update_histories(const Position &pos,
+                              const Move &best,
+                              const Move *quiets,
+                              const int num_quiets,
+                              const int depth,
+                              const int ply) noexcept {
+    const auto side = pos.get_turn();
+    const auto prev = ply > 0 ? stack_[ply - 1] : Move::nomove();
+    const int bonus = std::min(depth * depth, max_history);
+
+    histories_->killers.update(ply, best);
+    histories_->counters.update(side, prev, best);
+    histories_->butterfly.update(side, best, bonus);
+    histories_->continuation.update(prev, best, bonus);
+
+    for (int i = 0; i < num_quiets; ++i) {
+        histories_->butterfly.update(side, quiets[i], -bonus);
+        histories_->continuation.update(prev, quiets[i], -bonus);
+    }
+}
+
+}  // namespace libataxx::search
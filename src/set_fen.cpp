@@ -1,93 +1,158 @@
-#include <sstream>
-#include <string>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
 #include "libataxx/position.hpp"
 
 namespace libataxx {
 
-void Position::set_fen(const std::string &fen) noexcept {
-    if (fen == "startpos") {
+namespace {
+
+// Board characters either place a piece or skip empty squares. Empty squares
+// are written to a spare bitboard so every square is handled without a branch
+enum Kind : std::uint8_t
+{
+    KindBlack = 0,
+    KindWhite,
+    KindGap,
+    KindEmpty,
+    KindSlash,
+    KindInvalid
+};
+
+struct CharInfo {
+    std::uint8_t kind = KindInvalid;
+    std::uint8_t width = 0;
+};
+
+constexpr auto char_table = []() {
+    std::array<CharInfo, 256> table{};
+    for (const auto c : {'x', 'X', 'b', 'B'}) {
+        table[static_cast<unsigned char>(c)] = {KindBlack, 1};
+    }
+    for (const auto c : {'o', 'O', 'w', 'W'}) {
+        table[static_cast<unsigned char>(c)] = {KindWhite, 1};
+    }
+    table['-'] = {KindGap, 1};
+    table['/'] = {KindSlash, 0};
+    for (int i = 1; i <= 7; ++i) {
+        table['0' + i] = {KindEmpty, static_cast<std::uint8_t>(i)};
+    }
+    return table;
+}();
+
+[[nodiscard]] constexpr bool is_space(const char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+[[nodiscard]] constexpr std::string_view trim(std::string_view str) noexcept {
+    while (!str.empty() && is_space(str.front())) {
+        str.remove_prefix(1);
+    }
+    while (!str.empty() && is_space(str.back())) {
+        str.remove_suffix(1);
+    }
+    return str;
+}
+
+// Splits off the next whitespace separated field
+[[nodiscard]] constexpr std::string_view next_field(std::string_view &str) noexcept {
+    std::size_t i = 0;
+    while (i < str.size() && !is_space(str[i])) {
+        ++i;
+    }
+    const auto field = str.substr(0, i);
+    str.remove_prefix(i);
+    while (!str.empty() && is_space(str.front())) {
+        str.remove_prefix(1);
+    }
+    return field;
+}
+
+[[nodiscard]] bool parse_counter(const std::string_view field, unsigned int &value) noexcept {
+    const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+    return ec == std::errc{} && ptr == field.data() + field.size();
+}
+
+}  // namespace
+
+FenError Position::set_fen(const std::string_view fen) noexcept {
+    auto str = trim(fen);
+    if (str == "startpos") {
         return set_fen("x5o/7/7/7/7/7/o5x x 0 1");
     }
 
-    // Clear board
-    pieces_[static_cast<int>(Side::Black)].clear();
-    pieces_[static_cast<int>(Side::White)].clear();
-    gaps_.clear();
-    halfmoves_ = 0;
-    fullmoves_ = 1;
-    turn_ = Side::Black;
-
-    std::stringstream ss{fen};
-    std::string word;
-    int y = 6;
-    int x = 0;
-
-    // Position
-    if (ss >> word) {
-        for (const auto &c : word) {
-            const auto f = File{x};
-            const auto r = Rank{y};
-            const auto sq = Square{f, r};
-            const auto bb = Bitboard{sq};
-
-            switch (c) {
-                case 'x':
-                case 'X':
-                case 'b':
-                case 'B':
-                    pieces_[static_cast<int>(Side::Black)] ^= bb;
-                    x++;
-                    break;
-                case 'o':
-                case 'O':
-                case 'w':
-                case 'W':
-                    pieces_[static_cast<int>(Side::White)] ^= bb;
-                    x++;
-                    break;
-                case '-':
-                    gaps_ ^= bb;
-                    x++;
-                    break;
-                case '1':
-                case '2':
-                case '3':
-                case '4':
-                case '5':
-                case '6':
-                case '7':
-                    x += c - '0';
-                    break;
-                case '/':
-                    break;
-                default:
-                    return;
+    // Board
+    // Ranks have to fill all 7 files, a trailing '/' is allowed
+    std::uint64_t bbs[4] = {};
+    int rank = 6;
+    int file = 0;
+    for (const auto c : next_field(str)) {
+        const auto info = char_table[static_cast<unsigned char>(c)];
+        if (info.kind == KindSlash) {
+            if (file != 7) {
+                return FenError::InvalidBoard;
             }
-
-            if (x > 6) {
-                x = 0;
-                y--;
+            if (rank > 0) {
+                rank--;
+                file = 0;
             }
+            continue;
         }
+        if (info.kind == KindInvalid || file + info.width > 7) {
+            return FenError::InvalidBoard;
+        }
+        bbs[info.kind] |= 1ULL << (8 * rank + file);
+        file += info.width;
+    }
+    if (rank != 0 || file != 7) {
+        return FenError::InvalidBoard;
     }
 
     // Turn
-    if (ss >> word) {
-        if (word == "b" || word == "B" || word == "x" || word == "X") {
-            turn_ = Side::Black;
+    auto turn = Side::Black;
+    if (!str.empty()) {
+        const auto field = next_field(str);
+        if (field.size() != 1) {
+            return FenError::InvalidTurn;
+        }
+        const auto kind = char_table[static_cast<unsigned char>(field[0])].kind;
+        if (kind == KindBlack) {
+            turn = Side::Black;
+        } else if (kind == KindWhite) {
+            turn = Side::White;
         } else {
-            turn_ = Side::White;
+            return FenError::InvalidTurn;
         }
     }
 
     // Halfmove clock
-    ss >> halfmoves_;
+    unsigned int halfmoves = 0;
+    if (!str.empty() && !parse_counter(next_field(str), halfmoves)) {
+        return FenError::InvalidHalfmoves;
+    }
 
     // Fullmove counter
-    ss >> fullmoves_;
+    unsigned int fullmoves = 1;
+    if (!str.empty() && !parse_counter(next_field(str), fullmoves)) {
+        return FenError::InvalidFullmoves;
+    }
+
+    if (!str.empty()) {
+        return FenError::TrailingCharacters;
+    }
+
+    pieces_[static_cast<int>(Side::Black)] = Bitboard{bbs[KindBlack]};
+    pieces_[static_cast<int>(Side::White)] = Bitboard{bbs[KindWhite]};
+    gaps_ = Bitboard{bbs[KindGap]};
+    halfmoves_ = halfmoves;
+    fullmoves_ = fullmoves;
+    turn_ = turn;
 
     // Calculate initial hash
     hash_ = calculate_hash();
+
+    return FenError::None;
 }
 
 }  // namespace libataxx
@@ -0,0 +1,176 @@
+#include "libataxx/sprt.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace libataxx::sprt {
+
+namespace {
+
+// Two sided 95% quantile of the normal distribution
+constexpr double z95 = 1.959963984540054;
+
+// Per game score of each pentanomial outcome
+constexpr double pair_scores[5] = {0.0, 0.25, 0.5, 0.75, 1.0};
+
+// Outcomes that haven't happened yet are given a tiny weight, so one sided
+// results like nothing but wins still have a defined likelihood
+constexpr double unseen_weight = 1e-3;
+
+// Maximum likelihood distribution over the pair outcomes with the given
+// expected score, found from the observed frequencies with a Lagrange
+// multiplier: p_i = q_i / (1 + lambda * (x_i - score))
+[[nodiscard]] std::array<double, 5> constrained_mle(const std::array<double, 5> &q, const double score) noexcept {
+    // The constraint is decreasing in lambda, and every p_i has to stay positive
+    const auto constraint = [&](const double lambda) {
+        double sum = 0.0;
+        for (int i = 0; i < 5; ++i) {
+            const auto d = pair_scores[i] - score;
+            sum += q[i] * d / (1.0 + lambda * d);
+        }
+        return sum;
+    };
+
+    double lo = -1.0 / (1.0 - score);
+    double hi = 1.0 / score;
+    for (int i = 0; i < 100; ++i) {
+        const auto mid = (lo + hi) / 2.0;
+        if (constraint(mid) > 0.0) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const auto lambda = (lo + hi) / 2.0;
+    std::array<double, 5> p{};
+    double total = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        p[i] = q[i] / (1.0 + lambda * (pair_scores[i] - score));
+        total += p[i];
+    }
+    for (auto &x : p) {
+        x /= total;
+    }
+    return p;
+}
+
+}  // namespace
+
+[[nodiscard]] double Pentanomial::mean() const noexcept {
+    const auto n = pairs();
+    if (n == 0) {
+        return 0.5;
+    }
+
+    double sum = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        sum += pair_scores[i] * counts[i];
+    }
+    return sum / n;
+}
+
+[[nodiscard]] double Pentanomial::variance() const noexcept {
+    const auto n = pairs();
+    if (n == 0) {
+        return 0.0;
+    }
+
+    const auto m = mean();
+    double sum = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        sum += (pair_scores[i] - m) * (pair_scores[i] - m) * counts[i];
+    }
+    return sum / n;
+}
+
+[[nodiscard]] double score_to_elo(const double score) noexcept {
+    if (score <= 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    if (score >= 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+[[nodiscard]] double elo_to_score(const double elo) noexcept {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+[[nodiscard]] Elo elo(const Pentanomial &penta) noexcept {
+    const auto n = penta.pairs();
+    if (n == 0) {
+        return {};
+    }
+
+    const auto m = penta.mean();
+    const auto se = std::sqrt(penta.variance() / n);
+    const auto lo = score_to_elo(m - z95 * se);
+    const auto hi = score_to_elo(m + z95 * se);
+    if (!std::isfinite(lo) || !std::isfinite(hi)) {
+        return {score_to_elo(m), std::numeric_limits<double>::infinity()};
+    }
+    return {score_to_elo(m), (hi - lo) / 2.0};
+}
+
+[[nodiscard]] double los(const Pentanomial &penta) noexcept {
+    const auto n = penta.pairs();
+    const auto m = penta.mean();
+    const auto se = std::sqrt(penta.variance() / std::max<std::uint64_t>(n, 1));
+    if (se == 0.0) {
+        return m > 0.5 ? 1.0 : m < 0.5 ? 0.0 : 0.5;
+    }
+    return 0.5 * (1.0 + std::erf((m - 0.5) / (se * std::sqrt(2.0))));
+}
+
+SPRT::SPRT(const double elo0, const double elo1, const double alpha, const double beta) noexcept
+    : elo0_{elo0}, elo1_{elo1}, lower_{std::log(beta / (1.0 - alpha))}, upper_{std::log((1.0 - beta) / alpha)} {
+}
+
+Status SPRT::add(const int half_points) noexcept {
+    penta_.add(half_points);
+    return status();
+}
+
+[[nodiscard]] Status SPRT::status() const noexcept {
+    const auto value = llr();
+    if (value >= upper_) {
+        return Status::AcceptH1;
+    }
+    if (value <= lower_) {
+        return Status::AcceptH0;
+    }
+    return Status::Continue;
+}
+
+[[nodiscard]] double SPRT::llr() const noexcept {
+    const auto n = penta_.pairs();
+    if (n == 0) {
+        return 0.0;
+    }
+
+    std::array<double, 5> q{};
+    double total = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        q[i] = penta_.counts[i] > 0 ? static_cast<double>(penta_.counts[i]) : unseen_weight;
+        total += q[i];
+    }
+    for (auto &x : q) {
+        x /= total;
+    }
+
+    // Generalised log-likelihood ratio of the two best fitting distributions
+    const auto p0 = constrained_mle(q, elo_to_score(elo0_));
+    const auto p1 = constrained_mle(q, elo_to_score(elo1_));
+    double llr = 0.0;
+    for (int i = 0; i < 5; ++i) {
+        if (penta_.counts[i] > 0) {
+            llr += penta_.counts[i] * std::log(p1[i] / p0[i]);
+        }
+    }
+    return llr;
+}
+
+}  // namespace libataxx::sprt
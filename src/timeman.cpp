@@ -0,0 +1,96 @@
+#include "libataxx/timeman.hpp"
+#include <algorithm>
+
+namespace libataxx::timeman {
+
+[[nodiscard]] int expected_moves(const Clock &clock, const Position &pos, const Policy &policy) noexcept {
+    const int empties = pos.get_empty().count();
+    const int estimate = std::clamp(empties / 2 + policy.movestogo_margin, policy.min_movestogo, policy.max_movestogo);
+    if (clock.movestogo > 0) {
+        return std::min(clock.movestogo, estimate);
+    }
+    return estimate;
+}
+
+[[nodiscard]] Allocation allocate(const Clock &clock, const Position &pos, const Policy &policy) noexcept {
+    using std::chrono::milliseconds;
+
+    if (clock.time.count() <= 0) {
+        return {};
+    }
+
+    const auto usable = std::max(milliseconds(1), clock.time - policy.move_overhead);
+    const auto share = clock.time / expected_moves(clock, pos, policy) + clock.inc * policy.inc_percent / 100;
+    const auto soft = std::clamp(share, milliseconds(1), usable);
+
+    // The last move before the time control can use all of it
+    const double max_share = clock.movestogo == 1 ? 1.0 : policy.max_clock_share;
+    const auto hard = milliseconds(static_cast<std::int64_t>(
+        std::min(soft.count() * policy.hard_scale, std::max<double>(soft.count(), clock.time.count() * max_share))));
+
+    return {soft, std::clamp(hard, soft, usable)};
+}
+
+void TimeManager::start() noexcept {
+    start_ = std::chrono::steady_clock::now();
+    next_check_ = policy_.check_interval;
+    expired_ = false;
+    bestmove_ = Move::nomove();
+    stable_iterations_ = 0;
+    last_score_ = 0;
+    score_drop_ = 0;
+    iterations_ = 0;
+}
+
+void TimeManager::restart(const Allocation &allocation) noexcept {
+    allocation_ = allocation;
+    start_ = std::chrono::steady_clock::now();
+    next_check_ = 0;
+    expired_ = false;
+}
+
+void TimeManager::update([[maybe_unused]] const int depth, const Move &bestmove, const int score) noexcept {
+    if (iterations_ > 0) {
+        stable_iterations_ = bestmove == bestmove_ ? stable_iterations_ + 1 : 0;
+        score_drop_ = std::max(0, last_score_ - score);
+    }
+    bestmove_ = bestmove;
+    last_score_ = score;
+    iterations_++;
+}
+
+[[nodiscard]] double TimeManager::scale() const noexcept {
+    const double stability = std::clamp(policy_.max_stability - policy_.stability_step * stable_iterations_,
+                                        policy_.min_stability,
+                                        policy_.max_stability);
+    const double drop = 1.0 + std::min(1.0, static_cast<double>(score_drop_) / policy_.score_drop_scale);
+    return stability * drop;
+}
+
+[[nodiscard]] bool TimeManager::should_continue() const noexcept {
+    if (expired_) {
+        return false;
+    }
+    if (allocation_.soft.count() <= 0) {
+        return true;
+    }
+
+    const auto limit = std::min<double>(allocation_.soft.count() * scale(),
+                                        allocation_.hard.count() > 0 ? allocation_.hard.count() : 1e18);
+    return elapsed().count() < limit;
+}
+
+[[nodiscard]] bool TimeManager::should_stop(const std::uint64_t nodes) noexcept {
+    if (expired_) {
+        return true;
+    }
+    if (allocation_.hard.count() <= 0 || nodes < next_check_) {
+        return false;
+    }
+
+    next_check_ = nodes + policy_.check_interval;
+    expired_ = elapsed() >= allocation_.hard;
+    return expired_;
+}
+
+}  // namespace libataxx::timeman
@@ -0,0 +1,452 @@
+#include "libataxx/uai.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace libataxx::uai {
+
+namespace {
+
+constexpr int max_multipv = 64;
+
+// How often a stop is repeated until the search finishes
+constexpr std::chrono::milliseconds stop_interval{1};
+
+[[nodiscard]] std::string move_string(const Move &move) {
+    if (move == Move::nomove()) {
+        return "(none)";
+    }
+    return static_cast<std::string>(move);
+}
+
+}  // namespace
+
+[[nodiscard]] Option::operator std::string() const {
+    std::string str = "option name " + name + " type ";
+    switch (type) {
+        case Type::Check:
+            return str + "check default " + default_value;
+        case Type::Spin:
+            return str + "spin default " + default_value + " min " + std::to_string(min) + " max " +
+                   std::to_string(max);
+        case Type::Button:
+            return str + "button";
+        default:
+            return str + "string default " + (default_value.empty() ? "<empty>" : default_value);
+    }
+}
+
+[[nodiscard]] GoParams parse_go(const std::string &line) {
+    GoParams params;
+    std::stringstream ss{line};
+    std::string word;
+
+    const auto read_ms = [&ss]() {
+        long long n = 0;
+        ss >> n;
+        return std::chrono::milliseconds(std::max(0LL, n));
+    };
+
+    while (ss >> word) {
+        if (word == "depth") {
+            ss >> params.depth;
+        } else if (word == "nodes") {
+            ss >> params.nodes;
+        } else if (word == "movetime") {
+            params.movetime = read_ms();
+        } else if (word == "btime") {
+            params.btime = read_ms();
+        } else if (word == "wtime") {
+            params.wtime = read_ms();
+        } else if (word == "binc") {
+            params.binc = read_ms();
+        } else if (word == "winc") {
+            params.winc = read_ms();
+        } else if (word == "movestogo") {
+            ss >> params.movestogo;
+        } else if (word == "infinite") {
+            params.infinite = true;
+        } else if (word == "ponder") {
+            params.ponder = true;
+        }
+    }
+
+    return params;
+}
+
+[[nodiscard]] timeman::Clock get_clock(const GoParams &params, const Side side) noexcept {
+    const bool black = side == Side::Black;
+    return timeman::Clock{black ? params.btime : params.wtime, black ? params.binc : params.winc, params.movestogo};
+}
+
+[[nodiscard]] timeman::Allocation default_time_manager(const GoParams &params, const Position &pos) noexcept {
+    if (params.movetime.count() > 0) {
+        return {params.movetime, params.movetime};
+    }
+    return timeman::allocate(get_clock(params, pos.get_turn()), pos);
+}
+
+[[nodiscard]] std::string format_info(const search::Info &info) {
+    std::string str = "info depth " + std::to_string(info.depth);
+    if (info.multipv > 0) {
+        str += " multipv " + std::to_string(info.multipv);
+    }
+
+    if (info.score > search::mate_bound) {
+        str += " score mate " + std::to_string((search::mate_score - info.score + 1) / 2);
+    } else if (info.score < -search::mate_bound) {
+        str += " score mate -" + std::to_string((search::mate_score + info.score) / 2);
+    } else {
+        str += " score cp " + std::to_string(info.score);
+    }
+
+    const auto ms = std::max<std::int64_t>(1, info.time.count());
+    str += " nodes " + std::to_string(info.nodes);
+    str += " nps " + std::to_string(info.nodes * 1000 / ms);
+    str += " time " + std::to_string(info.time.count());
+
+    if (!info.pv.empty()) {
+        str += " pv";
+        for (const auto &move : info.pv) {
+            str += " " + move_string(move);
+        }
+    }
+
+    return str;
+}
+
+[[nodiscard]] std::vector<Option> SearchEngine::options() const {
+    std::vector<Option> options = {Option{"Hash", Option::Type::Spin, "16", 1, 4096},
+                                   Option{"Ponder", Option::Type::Check, "false"},
+                                   Option{"MultiPV", Option::Type::Spin, "1", 1, max_multipv}};
+
+    // Search parameters are exposed for tuning
+    const search::Params defaults;
+    for (const auto &info : search::param_info) {
+        options.push_back(
+            Option{info.name, Option::Type::Spin, std::to_string(defaults.*info.value), info.min, info.max});
+    }
+
+    return options;
+}
+
+void SearchEngine::set_option(const std::string &name, const std::string &value) {
+    if (name == "Hash") {
+        search_.resize(std::clamp(std::stoi(value), 1, 4096));
+        return;
+    }
+    // Pondering is up to the GUI, the table is kept warm either way
+    if (name == "Ponder") {
+        return;
+    }
+    if (name == "MultiPV") {
+        multipv_ = std::clamp(std::stoi(value), 1, max_multipv);
+        return;
+    }
+
+    auto params = search_.params();
+    if (search::set_param(params, name, std::stoi(value))) {
+        search_.set_params(params);
+    }
+}
+
+[[nodiscard]] search::Result SearchEngine::go(const Position &pos,
+                                              const search::Limits &limits,
+                                              const InfoHandler &info) {
+    auto search_limits = limits;
+    search_limits.multipv = multipv_;
+    search_.set_info_handler(info);
+    return search_.go(pos, search_limits);
+}
+
+[[nodiscard]] std::vector<Option> MCTSEngine::options() const {
+    return {Option{"Ponder", Option::Type::Check, "false"}};
+}
+
+[[nodiscard]] search::Result MCTSEngine::go(const Position &pos,
+                                            const search::Limits &limits,
+                                            const InfoHandler &info) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto result = mcts_.go(pos, limits);
+    const auto elapsed = std::chrono::steady_clock::now() - t0;
+
+    if (info) {
+        info(search::Info{result.depth,
+                          result.score,
+                          result.nodes,
+                          std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+                          result.pv});
+    }
+
+    return result;
+}
+
+Driver::Driver(Engine &engine, std::istream &in, std::ostream &out) : engine_{engine}, in_{in}, out_{out} {
+    searcher_ = std::thread(&Driver::search_thread, this);
+    timer_ = std::thread(&Driver::timer_thread, this);
+}
+
+Driver::~Driver() {
+    handle_stop();
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        quit_ = true;
+    }
+    cv_.notify_all();
+
+    searcher_.join();
+    timer_.join();
+}
+
+void Driver::run() {
+    std::string line;
+    while (std::getline(in_, line)) {
+        if (!handle(line)) {
+            return;
+        }
+    }
+
+    // Let a normal search finish once the input runs out
+    bool hold = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        hold = hold_;
+    }
+    if (hold) {
+        handle_stop();
+    }
+    wait();
+}
+
+bool Driver::handle(const std::string &line) {
+    std::stringstream ss{line};
+    std::string command;
+    ss >> command;
+
+    try {
+        if (command == "uai") {
+            send("id name " + engine_.name());
+            send("id author " + engine_.author());
+            for (const auto &option : engine_.options()) {
+                send(static_cast<std::string>(option));
+            }
+            send("uaiok");
+        } else if (command == "isready") {
+            send("readyok");
+        } else if (command == "setoption") {
+            // setoption name <name> [value <value>]
+            std::string word;
+            std::string name;
+            std::string value;
+            std::string *target = nullptr;
+            while (ss >> word) {
+                if (word == "name") {
+                    target = &name;
+                } else if (word == "value") {
+                    target = &value;
+                } else if (target) {
+                    *target += (target->empty() ? "" : " ") + word;
+                }
+            }
+            engine_.set_option(name, value);
+        } else if (command == "uainewgame") {
+            handle_stop();
+            wait();
+            engine_.new_game();
+        } else if (command == "position") {
+            handle_position(line);
+        } else if (command == "go") {
+            handle_go(line);
+        } else if (command == "stop") {
+            handle_stop();
+        } else if (command == "ponderhit") {
+            handle_ponderhit();
+        } else if (command == "quit") {
+            handle_stop();
+            return false;
+        }
+    } catch (const std::exception &e) {
+        send(std::string("info string ") + e.what());
+    }
+
+    return true;
+}
+
+void Driver::wait() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this]() { return !searching_; });
+}
+
+void Driver::send(const std::string &line) {
+    std::lock_guard<std::mutex> lock(out_mtx_);
+    out_ << line << std::endl;
+}
+
+void Driver::handle_position(const std::string &line) {
+    std::stringstream ss{line};
+    std::string word;
+    ss >> word;
+
+    Position pos;
+    ss >> word;
+    if (word == "startpos") {
+        pos = Position{"startpos"};
+        ss >> word;
+    } else if (word == "fen") {
+        std::string fen;
+        while (ss >> word && word != "moves") {
+            fen += (fen.empty() ? "" : " ") + word;
+        }
+        const auto parsed = Position::from_fen(fen);
+        if (!parsed) {
+            throw std::invalid_argument("Invalid FEN " + fen);
+        }
+        pos = *parsed;
+    } else {
+        throw std::invalid_argument("Invalid position command");
+    }
+
+    // Moves up to the first illegal one are kept
+    if (word == "moves") {
+        while (ss >> word) {
+            const auto move = Move::from_uai(word);
+            if (!pos.is_legal_move(move)) {
+                pos_ = pos;
+                throw std::invalid_argument("Illegal move " + word);
+            }
+            pos.makemove(move);
+        }
+    }
+
+    pos_ = pos;
+}
+
+void Driver::handle_go(const std::string &line) {
+    wait();
+
+    const auto params = parse_go(line);
+    const auto allocation = params.infinite ? timeman::Allocation{} : time_manager_(params, pos_);
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        job_pos_ = pos_;
+        job_params_ = params;
+        job_limits_.depth = params.depth;
+        job_limits_.nodes = params.nodes;
+        job_limits_.movetime = params.ponder ? std::chrono::milliseconds(0) : allocation.hard;
+        job_limits_.soft = params.ponder ? std::chrono::milliseconds(0) : allocation.soft;
+        allocation_ = allocation;
+        stop_requested_ = false;
+        hold_ = params.infinite || params.ponder;
+        pondering_ = params.ponder;
+        deadline_.reset();
+        if (!params.ponder && allocation.hard.count() > 0) {
+            deadline_ = std::chrono::steady_clock::now() + allocation.hard;
+        }
+        searching_ = true;
+        job_ready_ = true;
+    }
+    cv_.notify_all();
+}
+
+void Driver::handle_stop() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!searching_) {
+            return;
+        }
+        stop_requested_ = true;
+        hold_ = false;
+        pondering_ = false;
+        deadline_.reset();
+    }
+    engine_.stop();
+    cv_.notify_all();
+}
+
+void Driver::handle_ponderhit() {
+    bool started = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!searching_ || !pondering_) {
+            return;
+        }
+
+        // The opponent played the expected move, the clock starts now and the
+        // search carries on as a normal one with everything it found so far
+        pondering_ = false;
+        hold_ = job_params_.infinite;
+        if (allocation_.hard.count() > 0) {
+            deadline_ = std::chrono::steady_clock::now() + allocation_.hard;
+        }
+
+        started = !job_ready_;
+        if (!started) {
+            job_limits_.movetime = allocation_.hard;
+            job_limits_.soft = allocation_.soft;
+        }
+    }
+    if (started) {
+        engine_.ponderhit(allocation_);
+    }
+    cv_.notify_all();
+}
+
+void Driver::search_thread() {
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    for (;;) {
+        cv_.wait(lock, [this]() { return quit_ || job_ready_; });
+        if (quit_) {
+            return;
+        }
+
+        job_ready_ = false;
+        const auto pos = job_pos_;
+        const auto limits = job_limits_;
+        lock.unlock();
+
+        const auto result = engine_.go(pos, limits, [this](const search::Info &info) { send(format_info(info)); });
+
+        lock.lock();
+        cv_.wait(lock, [this]() { return quit_ || !hold_; });
+
+        std::string str = "bestmove " + move_string(result.bestmove);
+        if (result.pv.size() >= 2) {
+            str += " ponder " + move_string(result.pv[1]);
+        }
+        send(str);
+
+        searching_ = false;
+        stop_requested_ = false;
+        deadline_.reset();
+        cv_.notify_all();
+    }
+}
+
+void Driver::timer_thread() {
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (!quit_) {
+        if (searching_ && stop_requested_) {
+            // A stop can arrive before the engine has started searching and
+            // be cleared again, so keep repeating it until the search is over
+            lock.unlock();
+            engine_.stop();
+            lock.lock();
+            cv_.wait_for(lock, stop_interval);
+        } else if (deadline_) {
+            const auto deadline = *deadline_;
+            if (cv_.wait_until(lock, deadline) == std::cv_status::timeout && deadline_ == deadline) {
+                deadline_.reset();
+                stop_requested_ = true;
+            }
+        } else {
+            cv_.wait(lock);
+        }
+    }
+}
+
+}  // namespace libataxx::uai
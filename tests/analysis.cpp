@@ -0,0 +1,196 @@
+#include <libataxx/analysis.hpp>
+#include <libataxx/pgn.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/search.hpp>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+TEST_CASE("search::Search - Multi-PV") {
+    const libataxx::Position pos{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1"};
+    libataxx::search::Search search{1};
+    libataxx::search::Limits limits;
+    limits.depth = 4;
+    limits.multipv = 4;
+
+    const auto result = search.go(pos, limits);
+    REQUIRE(result.lines.size() == 4);
+    REQUIRE(result.lines.front().move == result.bestmove);
+    REQUIRE(result.lines.front().score == result.score);
+    REQUIRE(result.lines.front().pv == result.pv);
+
+    std::set<std::string> moves;
+    for (const auto &line : result.lines) {
+        REQUIRE(pos.is_legal_move(line.move));
+        REQUIRE(line.depth == 4);
+        REQUIRE(line.pv.front() == line.move);
+        moves.insert(static_cast<std::string>(line.move));
+    }
+    REQUIRE(moves.size() == 4);
+
+    // Never more lines than moves
+    const libataxx::Position pass{"7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1"};
+    const auto forced = search.go(pass, limits);
+    REQUIRE(forced.lines.size() == 1);
+    REQUIRE(forced.bestmove == libataxx::Move::nullmove());
+
+    // A single line by default
+    limits.multipv = 1;
+    REQUIRE(search.go(pos, limits).lines.size() == 1);
+
+    // Every line gets reported
+    int infos = 0;
+    limits.multipv = 3;
+    limits.depth = 2;
+    search.set_info_handler([&infos](const libataxx::search::Info &info) {
+        REQUIRE(info.multipv == infos % 3 + 1);
+        infos++;
+    });
+    [[maybe_unused]] const auto reported = search.go(pos, limits);
+    REQUIRE(infos == 6);
+}
+
+TEST_CASE("analysis::format_score") {
+    REQUIRE(libataxx::analysis::format_score(120, 8) == "+1.20/8");
+    REQUIRE(libataxx::analysis::format_score(-5, 3) == "-0.05/3");
+    REQUIRE(libataxx::analysis::format_score(0, 1) == "+0.00/1");
+    REQUIRE(libataxx::analysis::format_score(libataxx::search::mate_score - 5, 6) == "#3/6");
+    REQUIRE(libataxx::analysis::format_score(-libataxx::search::mate_score + 4, 6) == "#-2/6");
+}
+
+TEST_CASE("analysis::format_comment") {
+    libataxx::search::Result result;
+    const auto f2 = libataxx::Move::from_uai("f2");
+    const auto g3 = libataxx::Move::from_uai("g3");
+    const auto b6 = libataxx::Move::from_uai("b6");
+    result.lines = {{f2, 100, 7, {f2}}, {g3, 60, 7, {g3}}};
+
+    REQUIRE(libataxx::analysis::format_comment(result, f2) == "+1.00/7 [f2 +1.00/7, g3 +0.60/7]");
+    REQUIRE(libataxx::analysis::format_comment(result, g3) == "+0.60/7 best f2 +1.00/7 [f2 +1.00/7, g3 +0.60/7]");
+    REQUIRE(libataxx::analysis::format_comment(result, b6) == "best f2 +1.00/7 [f2 +1.00/7, g3 +0.60/7]");
+
+    result.lines.pop_back();
+    REQUIRE(libataxx::analysis::format_comment(result, f2) == "+1.00/7");
+}
+
+TEST_CASE("analysis::analyse") {
+    const std::vector<libataxx::Position> positions = {
+        libataxx::Position{"x5o/7/7/7/7/7/o5x x 0 1"},
+        libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1"},
+        libataxx::Position{"7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1"},
+        libataxx::Position{"7/7/7/7/3x3/ooo4/o1o4 x 0 1"},
+    };
+
+    libataxx::analysis::Options options;
+    options.limits.depth = 3;
+    options.threads = 3;
+    options.hash_mb = 1;
+
+    const auto results = libataxx::analysis::analyse(positions, options);
+    REQUIRE(results.size() == positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        REQUIRE(positions[i].is_legal_move(results[i].bestmove));
+        REQUIRE(results[i].depth == 3);
+    }
+    REQUIRE(results[2].bestmove == libataxx::Move::nullmove());
+    REQUIRE(results[3].bestmove == libataxx::Move::from_uai("d3b1"));
+}
+
+TEST_CASE("analysis::annotate") {
+    libataxx::pgn::PGN game;
+    auto *node = game.root();
+    for (const auto &move : {"f1", "a2", "f2", "b1"}) {
+        node = node->add_mainline(libataxx::Move::from_uai(move));
+    }
+
+    libataxx::analysis::Options options;
+    options.limits.depth = 2;
+    options.limits.multipv = 2;
+    options.threads = 2;
+    options.hash_mb = 1;
+    libataxx::analysis::annotate(game, options);
+
+    int comments = 0;
+    const libataxx::pgn::Node *current = game.root();
+    while (current->has_children()) {
+        current = &current->children().front();
+        REQUIRE(current->has_comment());
+        REQUIRE(current->comment().find('[') != std::string::npos);
+        comments++;
+    }
+    REQUIRE(comments == 4);
+}
+
+TEST_CASE("analysis::analyse - Streaming") {
+    std::vector<libataxx::Position> positions;
+    for (const auto &fen :
+         {"x5o/7/7/7/7/7/o5x x 0 1", "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1", "7/7/7/7/3x3/ooo4/o1o4 x 0 1"}) {
+        for (int i = 0; i < 4; ++i) {
+            positions.emplace_back(fen);
+        }
+    }
+
+    libataxx::analysis::Options options;
+    options.limits.depth = 2;
+    options.threads = 4;
+    options.hash_mb = 1;
+    options.clear = true;
+
+    // In order, once each, starting from the first position asked for
+    std::vector<std::size_t> indices;
+    libataxx::analysis::analyse(
+        positions,
+        options,
+        [&](const std::size_t index, const libataxx::search::Result &result, const auto) {
+            REQUIRE(positions[index].is_legal_move(result.bestmove));
+            indices.push_back(index);
+        },
+        5);
+    REQUIRE(indices.size() == positions.size() - 5);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        REQUIRE(indices[i] == i + 5);
+    }
+
+    // Nothing left to search
+    libataxx::analysis::analyse(
+        positions, options, [](const auto, const auto &, const auto) { FAIL(); }, positions.size());
+
+    // The handler's exceptions stop the batch
+    int handled = 0;
+    REQUIRE_THROWS_AS(libataxx::analysis::analyse(positions,
+                                                  options,
+                                                  [&handled](const auto index, const auto &, const auto) {
+                                                      handled++;
+                                                      if (index == 2) {
+                                                          throw std::runtime_error("Write failed");
+                                                      }
+                                                  }),
+                      std::runtime_error);
+    REQUIRE(handled == 3);
+}
+
+TEST_CASE("analysis::Checkpoint") {
+    const std::string path = "analysis_checkpoint.tmp";
+    std::remove(path.c_str());
+
+    const auto empty = libataxx::analysis::read_checkpoint(path);
+    REQUIRE(empty.positions == 0);
+    REQUIRE(empty.bytes == 0);
+
+    libataxx::analysis::write_checkpoint(path, {1234, 56789});
+    libataxx::analysis::write_checkpoint(path, {1235, 56840});
+    const auto checkpoint = libataxx::analysis::read_checkpoint(path);
+    REQUIRE(checkpoint.positions == 1235);
+    REQUIRE(checkpoint.bytes == 56840);
+
+    {
+        std::ofstream fs{path};
+        fs << "garbage";
+    }
+    REQUIRE_THROWS(libataxx::analysis::read_checkpoint(path));
+    std::remove(path.c_str());
+}
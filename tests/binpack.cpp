@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <libataxx/binpack.hpp>
+#include <libataxx/position.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+[[nodiscard]] std::vector<libataxx::binpack::TrainingEntry> random_games(const int num_games) {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1",
+        "x5o/7/3-3/2-1-2/3-3/7/o5x o 0 1",
+        "x2-2o/3-3/2---2/7/2---2/3-3/o2-2x x 0 1",
+    };
+
+    std::mt19937 rng(7);
+    std::vector<libataxx::binpack::TrainingEntry> entries;
+
+    for (int i = 0; i < num_games; ++i) {
+        auto pos = libataxx::Position{fens[i % 4]};
+        std::vector<libataxx::binpack::TrainingEntry> game;
+
+        while (!pos.is_gameover()) {
+            libataxx::Move moves[libataxx::max_moves];
+            const int num_moves = pos.legal_moves(moves);
+            const auto move = moves[rng() % num_moves];
+            game.push_back({pos, move, static_cast<std::int16_t>(pos.get_us().count() - pos.get_them().count()), {}});
+            pos.makemove(move);
+        }
+        game.push_back({pos, libataxx::Move::nomove(), 0, {}});
+
+        for (auto &entry : game) {
+            entry.result = pos.get_result();
+        }
+        entries.insert(entries.end(), game.begin(), game.end());
+    }
+
+    return entries;
+}
+
+void require_equal(const libataxx::binpack::TrainingEntry &a, const libataxx::binpack::TrainingEntry &b) {
+    REQUIRE(a.pos.get_fen() == b.pos.get_fen());
+    REQUIRE(a.pos.get_hash() == b.pos.get_hash());
+    REQUIRE(a.move == b.move);
+    REQUIRE(a.score == b.score);
+    REQUIRE(a.result == b.result);
+}
+
+}  // namespace
+
+TEST_CASE("binpack - Chained games") {
+    const auto entries = random_games(20);
+    std::stringstream ss;
+
+    {
+        libataxx::binpack::Writer writer{ss, 4096};
+        for (const auto &entry : entries) {
+            writer.add(entry);
+        }
+        REQUIRE(writer.num_entries() == entries.size());
+        REQUIRE(writer.num_chains() == 20);
+    }
+
+    // Far smaller than three bitboards per entry
+    REQUIRE(ss.str().size() < 4 * entries.size());
+
+    libataxx::binpack::Reader reader{ss};
+    libataxx::binpack::TrainingEntry entry;
+    for (const auto &expected : entries) {
+        REQUIRE(reader.next(entry));
+        require_equal(entry, expected);
+    }
+    REQUIRE(!reader.next(entry));
+}
+
+TEST_CASE("binpack - Positions without a hash") {
+    const auto entries = random_games(4);
+
+    // The same games with every position rebuilt from its bitboards
+    std::stringstream ss;
+    {
+        libataxx::binpack::Writer writer{ss};
+        for (const auto &entry : entries) {
+            auto bare = entry;
+            bare.pos = libataxx::Position{entry.pos.get_black(),
+                                          entry.pos.get_white(),
+                                          entry.pos.get_gaps(),
+                                          entry.pos.get_halfmoves(),
+                                          entry.pos.get_fullmoves(),
+                                          entry.pos.get_turn()};
+            writer.add(bare);
+        }
+        REQUIRE(writer.num_chains() == 4);
+    }
+
+    libataxx::binpack::Reader reader{ss};
+    libataxx::binpack::TrainingEntry entry;
+    for (const auto &expected : entries) {
+        REQUIRE(reader.next(entry));
+        require_equal(entry, expected);
+    }
+    REQUIRE(!reader.next(entry));
+}
+
+TEST_CASE("binpack - Unrelated positions") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1",
+        "4o2/2x1o2/2x4/1o5/7/3o1oo/-x3-1 o 13 40",
+        "7/7/7/7/-------/-------/x5o o 0 1",
+        "x5o/7/7/7/7/7/o5x x 0 1",
+    };
+
+    std::vector<libataxx::binpack::TrainingEntry> entries;
+    for (const auto &fen : fens) {
+        entries.push_back({libataxx::Position{fen}, libataxx::Move::nomove(), -300, libataxx::Result::Draw});
+    }
+    entries[1].move = libataxx::Move::from_uai("c1");
+
+    std::stringstream ss;
+    {
+        libataxx::binpack::Writer writer{ss};
+        for (const auto &entry : entries) {
+            writer.add(entry);
+        }
+        REQUIRE(writer.num_chains() == entries.size());
+    }
+
+    libataxx::binpack::Reader reader{ss};
+    libataxx::binpack::TrainingEntry entry;
+    for (const auto &expected : entries) {
+        REQUIRE(reader.next(entry));
+        require_equal(entry, expected);
+    }
+    REQUIRE(!reader.next(entry));
+}
+
+TEST_CASE("binpack - Corrupt data") {
+    const auto entries = random_games(1);
+    std::stringstream ss;
+    {
+        libataxx::binpack::Writer writer{ss};
+        for (const auto &entry : entries) {
+            writer.add(entry);
+        }
+    }
+
+    auto data = ss.str();
+    data[data.size() - 1] ^= 0x55;
+    std::stringstream corrupt{data};
+    libataxx::binpack::Reader reader{corrupt};
+    libataxx::binpack::TrainingEntry entry;
+    REQUIRE_THROWS(reader.next(entry));
+}
+
+TEST_CASE("binpack - BatchLoader") {
+    const auto entries = random_games(30);
+    const auto path = std::filesystem::temp_directory_path() / "libataxx_binpack_test.bin";
+
+    {
+        std::ofstream fs(path, std::ios::binary);
+        libataxx::binpack::Writer writer{fs, 512};
+        for (const auto &entry : entries) {
+            writer.add(entry);
+        }
+    }
+
+    std::vector<std::uint64_t> expected;
+    for (const auto &entry : entries) {
+        expected.push_back(entry.pos.get_us().compressed() ^ entry.pos.get_them().compressed() << 1);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (const bool shuffle : {false, true}) {
+        libataxx::binpack::LoaderOptions options;
+        options.batch_size = 64;
+        options.threads = 3;
+        options.shuffle = shuffle;
+        options.shuffle_buffer = 256;
+
+        libataxx::binpack::BatchLoader loader{path.string(), options};
+        REQUIRE(loader.num_chunks() > 1);
+
+        std::vector<std::uint64_t> seen;
+        while (const auto batch = loader.next()) {
+            REQUIRE(batch->size() > 0);
+            REQUIRE(batch->size() <= options.batch_size);
+            for (std::size_t i = 0; i < batch->size(); ++i) {
+                REQUIRE((batch->us[i] & batch->them[i]) == 0);
+                REQUIRE((batch->us[i] >> 49) == 0);
+                REQUIRE(batch->results[i] >= 0.0f);
+                REQUIRE(batch->results[i] <= 1.0f);
+                seen.push_back(batch->us[i] ^ batch->them[i] << 1);
+            }
+        }
+        std::sort(seen.begin(), seen.end());
+        REQUIRE(seen == expected);
+    }
+
+    std::filesystem::remove(path);
+}
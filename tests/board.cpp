@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <libataxx/bitboard.hpp>
+#include <libataxx/board.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include <string>
+#include "catch.hpp"
+
+namespace {
+
+void compare(const libataxx::Board &board, const libataxx::Position &pos) {
+    libataxx::Move expected[libataxx::max_moves];
+    libataxx::Move moves[libataxx::max_moves];
+    const int num_expected = pos.legal_moves(expected);
+    const int num_moves = board.legal_moves(pos, moves);
+    REQUIRE(num_moves == num_expected);
+    REQUIRE(std::equal(moves, moves + num_moves, expected));
+    REQUIRE(board.count_legal_moves(pos) == pos.count_legal_moves());
+    REQUIRE(board.get_reachable(pos) == pos.get_reachable());
+    REQUIRE(board.get_reachable(pos, libataxx::Side::Black) == pos.get_reachable(libataxx::Side::Black));
+    REQUIRE(board.get_reachable(pos, libataxx::Side::White) == pos.get_reachable(libataxx::Side::White));
+    REQUIRE(board.calculate_hash(pos) == pos.get_hash());
+}
+
+}  // namespace
+
+TEST_CASE("Board - Matches Position") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1",
+        "x2-2o/3-3/2---2/7/2---2/3-3/o2-2x x 0 1",
+        "x-1-1-o/-1-1-1-/1-1-1-1/-1-1-1-/1-1-1-1/-1-1-1-/o-1-1-x x 0 1",
+        "x1-1-1o/2-1-2/-------/2-1-2/-------/2-1-2/o1-1-1x x 0 1",
+        "x5o/6-/1-4-/-3--1/2-4/7/o-3-x x 0 1",
+        "x5o/7/7/-------/-------/7/o5x x 0 1",
+        "6o/7/-------/-------/7/7/6x x 0 1",
+        "4oox/4ooo/4ooo/7/7/7/7 o 0 1",
+    };
+
+    std::mt19937_64 rng(0);
+    for (const auto &fen : fens) {
+        REQUIRE(libataxx::Position::from_fen(fen));
+        const auto start = libataxx::Position{fen};
+        const auto board = libataxx::Board{start};
+        REQUIRE(board.matches(start));
+
+        for (int game = 0; game < 20; ++game) {
+            auto pos = start;
+            while (true) {
+                compare(board, pos);
+                const auto moves = pos.legal_moves();
+                if (moves.empty()) {
+                    break;
+                }
+                pos.makemove(moves[rng() % moves.size()]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Board - Tables") {
+    const libataxx::Board board{libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1"}};
+    const auto gaps = board.gaps();
+
+    REQUIRE((board.squares() | gaps) == libataxx::Bitboard(libataxx::Bitmask::All));
+    REQUIRE(!(board.squares() & gaps));
+    for (const auto &sq : gaps) {
+        REQUIRE(!board.singles(sq));
+        REQUIRE(!board.doubles(sq));
+    }
+    for (const auto &sq : board.squares()) {
+        REQUIRE(!(board.singles(sq) & gaps));
+        REQUIRE(!(board.doubles(sq) & gaps));
+        REQUIRE((board.singles(sq) | gaps) == (libataxx::Bitboard{sq}.singles() | gaps));
+        REQUIRE((board.doubles(sq) | gaps) == (libataxx::Bitboard{sq}.doubles() | gaps));
+    }
+
+    libataxx::Bitboard hashed;
+    REQUIRE(libataxx::Board{hashed}.gaps_hash() == 0);
+    REQUIRE(board.gaps_hash() != 0);
+}
+
+TEST_CASE("Board - Regions") {
+    // Open boards are one region
+    const libataxx::Board open{};
+    REQUIRE(open.regions().size() == 1);
+    REQUIRE(open.regions()[0] == libataxx::Bitboard(libataxx::Bitmask::All));
+
+    // Two rows of gaps can't be jumped
+    const libataxx::Board split{libataxx::Position{"x5o/7/7/-------/-------/7/o5x x 0 1"}};
+    REQUIRE(split.regions().size() == 2);
+    REQUIRE(split.regions()[0] == libataxx::Bitboard{0x7f7fULL});
+    REQUIRE(split.regions()[1] == libataxx::Bitboard{0x7f7f7f00000000ULL});
+    REQUIRE(split.region(libataxx::Square{libataxx::SquareIndex::A1}) == split.regions()[0]);
+    REQUIRE(split.region(libataxx::Square{libataxx::SquareIndex::G7}) == split.regions()[1]);
+    REQUIRE(!split.region(libataxx::Square{libataxx::SquareIndex::D4}));
+
+    // One row can
+    const libataxx::Board jumped{libataxx::Position{"x5o/7/7/-------/7/7/o5x x 0 1"}};
+    REQUIRE(jumped.regions().size() == 1);
+}
+
+TEST_CASE("Board - Symmetries") {
+    const std::pair<std::string, std::size_t> tests[] = {
+        {"x5o/7/7/7/7/7/o5x x 0 1", 8},
+        {"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1", 8},
+        {"x5o/7/7/-------/7/7/o5x x 0 1", 4},
+        {"x5o/7/7/-------/-------/7/o5x x 0 1", 2},
+        {"x-4o/-6/7/7/7/7/o5x x 0 1", 2},
+        {"x5o/6-/1-4-/-3--1/2-4/7/o-3-x x 0 1", 1},
+    };
+
+    for (const auto &[fen, count] : tests) {
+        REQUIRE(libataxx::Position::from_fen(fen));
+        const libataxx::Board board{libataxx::Position{fen}};
+        REQUIRE(board.symmetries().size() == count);
+        REQUIRE(board.symmetries().front() == libataxx::Transform::None);
+        for (const auto t : libataxx::transforms) {
+            const bool fixed = libataxx::transform(board.gaps(), t) == board.gaps();
+            REQUIRE(board.is_symmetry(t) == fixed);
+            REQUIRE(std::count(board.symmetries().begin(), board.symmetries().end(), t) == fixed);
+        }
+    }
+}
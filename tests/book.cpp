@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <libataxx/book.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+[[nodiscard]] std::string write_book(libataxx::book::Builder &builder, const std::string &name) {
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream fs(path, std::ios::binary);
+    builder.write(fs);
+    return path;
+}
+
+}  // namespace
+
+TEST_CASE("Book - Probe") {
+    std::stringstream in{
+        "[Result \"0-1\"]\n"
+        "\n"
+        "1. g2 a2 2. g3 0-1\n"
+        "\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1. g2 a2 2. f2 1-0\n"
+        "\n"
+        "[Result \"1/2-1/2\"]\n"
+        "\n"
+        "1. a6 g6 1/2-1/2\n"
+        "\n"
+        "[Result \"*\"]\n"
+        "\n"
+        "1. a6 g6 *\n"};
+
+    libataxx::book::Builder builder;
+    builder.add_pgn(in);
+    REQUIRE(builder.size() == 6);
+
+    const auto path = write_book(builder, "libataxx-test.book");
+    const libataxx::book::Book book{path};
+    REQUIRE(book.size() == 6);
+    REQUIRE(!book.symmetric());
+
+    auto pos = libataxx::Position{"startpos"};
+    const auto moves = book.probe(pos);
+    REQUIRE(moves.size() == 2);
+    REQUIRE(moves[0].move == libataxx::Move::from_uai("g2"));
+    REQUIRE(moves[0].games == 2);
+    REQUIRE(moves[0].wins == 1);
+    REQUIRE(moves[0].losses() == 1);
+    REQUIRE(moves[1].move == libataxx::Move::from_uai("a6"));
+    REQUIRE(moves[1].draws == 1);
+    REQUIRE(moves[1].score() == 0.5f);
+
+    pos.makemove(libataxx::Move::from_uai("g2"));
+    pos.makemove(libataxx::Move::from_uai("a2"));
+    const auto replies = book.probe(pos);
+    REQUIRE(replies.size() == 2);
+    REQUIRE(replies[0].wins + replies[1].wins == 1);
+
+    REQUIRE(!book.pick(libataxx::Position{"x5o/7/7/7/7/7/o5x o 0 1"}, 0));
+    for (std::uint64_t r = 0; r < 4; ++r) {
+        REQUIRE(book.probe(pos).size() == 2);
+        REQUIRE(pos.is_legal_move(book.pick(pos, r)));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Book - Symmetric") {
+    libataxx::book::BuilderOptions options;
+    options.symmetric = true;
+    libataxx::book::Builder builder{options};
+
+    // Two games that are rotations of each other
+    auto pos = libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1"};
+    const std::vector<libataxx::Move> game = {
+        libataxx::Move::from_uai("g2"),
+        libataxx::Move::from_uai("a2"),
+        libataxx::Move::from_uai("g1e2"),
+    };
+    std::vector<libataxx::Move> rotated;
+    for (const auto &move : game) {
+        rotated.push_back(libataxx::transform(move, libataxx::Transform::Rot180));
+    }
+    builder.add_game(pos, game, libataxx::Result::BlackWin);
+    builder.add_game(libataxx::transform(pos, libataxx::Transform::Rot180), rotated, libataxx::Result::BlackWin);
+
+    const auto path = write_book(builder, "libataxx-test-symmetric.book");
+    const libataxx::book::Book book{path};
+    REQUIRE(book.symmetric());
+
+    // Every orientation of a book position gets the matching moves
+    pos.makemove(game[0]);
+    pos.makemove(game[1]);
+    for (const auto t : libataxx::transforms) {
+        const auto moves = book.probe(libataxx::transform(pos, t));
+        REQUIRE(moves.size() >= 1);
+        REQUIRE(moves.size() <= 2);
+        std::uint32_t games = 0;
+        for (const auto &move : moves) {
+            REQUIRE(libataxx::transform(pos, t).is_legal_move(move.move));
+            games += move.games;
+            REQUIRE(move.wins == move.games);
+        }
+        REQUIRE(games == 2);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Book - Gap symmetries") {
+    libataxx::book::BuilderOptions options;
+    options.symmetric = true;
+    libataxx::book::Builder builder{options};
+
+    // The layout only has a diagonal symmetry, so its mirror image is a
+    // different layout and a different book position
+    const auto pos = libataxx::Position{"x-4o/-6/7/7/7/7/o5x x 0 1"};
+    const auto mirrored = libataxx::transform(pos, libataxx::Transform::FlipH);
+    REQUIRE(pos.get_symmetries() != libataxx::all_symmetries);
+    const auto f2 = libataxx::Move::from_uai("f2");
+    builder.add_game(pos, {f2}, libataxx::Result::BlackWin);
+    builder.add_game(mirrored, {libataxx::transform(f2, libataxx::Transform::FlipH)}, libataxx::Result::WhiteWin);
+
+    auto path = write_book(builder, "libataxx-test-gaps.book");
+    {
+        const libataxx::book::Book book{path};
+        for (const auto t : libataxx::transforms) {
+            const auto tpos = libataxx::transform(pos, t);
+            const auto moves = book.probe(tpos);
+            REQUIRE(book.probe(tpos, tpos.get_symmetries()).size() == moves.size());
+
+            // Orientations on neither layout were never played
+            if (tpos.get_gaps() != pos.get_gaps() && tpos.get_gaps() != mirrored.get_gaps()) {
+                REQUIRE(moves.empty());
+                continue;
+            }
+            REQUIRE(moves.size() == 1);
+            REQUIRE(moves.front().games == 1);
+            REQUIRE(moves.front().wins == (tpos.get_gaps() == pos.get_gaps()));
+        }
+    }
+    std::filesystem::remove(path);
+
+    // Books written before gap symmetries were flagged are keyed over every
+    // transform, which is the same on fully symmetric layouts
+    libataxx::book::Builder open{options};
+    const auto startpos = libataxx::Position{"startpos"};
+    open.add_game(startpos, {f2}, libataxx::Result::BlackWin);
+    path = write_book(open, "libataxx-test-old.book");
+    {
+        std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekp(8);
+        fs.put(1);
+    }
+    {
+        const libataxx::book::Book book{path};
+        REQUIRE(book.symmetric());
+        for (const auto t : libataxx::transforms) {
+            REQUIRE(book.probe(libataxx::transform(startpos, t)).size() == 1);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Book - Large") {
+    std::mt19937_64 rng(0);
+    libataxx::book::BuilderOptions options;
+    options.max_ply = 30;
+    libataxx::book::Builder builder{options};
+    std::vector<std::pair<libataxx::Position, libataxx::Move>> added;
+
+    for (int i = 0; i < 2000; ++i) {
+        auto pos = libataxx::Position{"startpos"};
+        std::vector<libataxx::Move> moves;
+        for (int ply = 0; ply < 30 && !pos.is_gameover(); ++ply) {
+            const auto legal = pos.legal_moves();
+            const auto move = legal[rng() % legal.size()];
+            if (move != libataxx::Move::nullmove()) {
+                added.emplace_back(pos, move);
+            }
+            moves.push_back(move);
+            pos.makemove(move);
+        }
+        builder.add_game(libataxx::Position{"startpos"}, moves, libataxx::Result::Draw);
+    }
+
+    const auto path = write_book(builder, "libataxx-test-large.book");
+    const libataxx::book::Book book{path};
+    REQUIRE(book.size() == builder.size());
+
+    for (std::size_t i = 0; i < added.size(); i += 7) {
+        const auto &[pos, move] = added[i];
+        const auto moves = book.probe(pos);
+        REQUIRE(std::any_of(moves.begin(), moves.end(), [&](const auto &m) { return m.move == move; }));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Book - Invalid") {
+    const auto path = (std::filesystem::temp_directory_path() / "libataxx-test-invalid.book").string();
+    {
+        std::ofstream fs(path, std::ios::binary);
+        fs << "not a book, not a book, not a book";
+    }
+    REQUIRE_THROWS(libataxx::book::Book{path});
+    std::filesystem::remove(path);
+    REQUIRE_THROWS(libataxx::book::Book{path});
+}
@@ -1,5 +1,7 @@
+#include <libataxx/fen.hpp>
 #include <libataxx/position.hpp>
 #include <string>
+#include <vector>
 #include "catch.hpp"
 
 TEST_CASE("Position::get_fen()") {
@@ -41,3 +43,42 @@ TEST_CASE("Position::get_fen() on incomplete strings") {
         REQUIRE(pos.get_fen() == expected);
     }
 }
+
+TEST_CASE("Position::write_fen()") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "xxxxxxx/ooooooo/-------/xox-oxo/1x1o1-1/x6/6o x 4294967295 4294967295",
+        "7/7/7/7/7/7/7 o 100 200",
+    };
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        char buffer[libataxx::Position::fen_buffer_size];
+        const auto end = pos.write_fen(buffer);
+        REQUIRE(std::string(buffer, end) == fen);
+        REQUIRE(static_cast<std::size_t>(end - buffer) <= libataxx::Position::fen_buffer_size);
+    }
+}
+
+TEST_CASE("fen::write_lines()") {
+    std::vector<libataxx::Position> positions;
+    std::string expected = "header\n";
+    auto pos = libataxx::Position{"startpos"};
+    for (int i = 0; i < 50 && !pos.is_gameover(); ++i) {
+        positions.push_back(pos);
+        expected += pos.get_fen() + "\n";
+        pos.makemove(pos.legal_moves()[i % pos.count_legal_moves()]);
+    }
+
+    std::string out = "header\n";
+    libataxx::fen::write_lines(positions, out);
+    REQUIRE(out == expected);
+
+    const auto parsed = libataxx::fen::parse_lines(out.substr(7));
+    REQUIRE(parsed.size() == positions.size());
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        REQUIRE(parsed[i]);
+        REQUIRE(parsed[i]->get_hash() == positions[i].get_hash());
+    }
+}
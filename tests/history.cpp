@@ -0,0 +1,72 @@
+#include <libataxx/history.hpp>
+#include <libataxx/position.hpp>
+#include <memory>
+#include <set>
+#include "catch.hpp"
+
+TEST_CASE("search::move_index") {
+    std::set<int> seen;
+    for (int from = 0; from < 49; ++from) {
+        for (int to = 0; to < 49; ++to) {
+            const auto move = libataxx::Move{libataxx::Square(from % 7, from / 7), libataxx::Square(to % 7, to / 7)};
+            const int idx = libataxx::search::move_index(move);
+            REQUIRE(idx >= 0);
+            REQUIRE(idx < libataxx::search::num_move_indices - 1);
+            seen.insert(idx);
+            REQUIRE(libataxx::search::target_index(move) == to);
+        }
+    }
+    REQUIRE(seen.size() == 49 * 49);
+    REQUIRE(libataxx::search::move_index(libataxx::Move::nullmove()) == libataxx::search::num_move_indices - 1);
+    REQUIRE(libataxx::search::target_index(libataxx::Move::nullmove()) == libataxx::search::num_target_indices - 1);
+}
+
+TEST_CASE("search::update_gravity") {
+    std::int16_t entry = 0;
+    for (int i = 0; i < 1000; ++i) {
+        libataxx::search::update_gravity(entry, 10000);
+        REQUIRE(entry <= libataxx::search::max_history);
+    }
+    REQUIRE(entry > libataxx::search::max_history - 100);
+
+    for (int i = 0; i < 1000; ++i) {
+        libataxx::search::update_gravity(entry, -100000);
+        REQUIRE(entry >= -libataxx::search::max_history);
+    }
+    REQUIRE(entry == -libataxx::search::max_history);
+}
+
+TEST_CASE("search::Histories") {
+    auto histories = std::make_unique<libataxx::search::Histories>();
+    const auto a = libataxx::Move::from_uai("b6");
+    const auto b = libataxx::Move::from_uai("a7c5");
+    const auto c = libataxx::Move::from_uai("f2");
+
+    histories->butterfly.update(libataxx::Side::Black, a, 100);
+    REQUIRE(histories->butterfly.get(libataxx::Side::Black, a) == 100);
+    REQUIRE(histories->butterfly.get(libataxx::Side::White, a) == 0);
+
+    histories->continuation.update(a, b, -50);
+    REQUIRE(histories->continuation.get(a, b) == -50);
+    REQUIRE(histories->continuation.get(b, a) == 0);
+
+    REQUIRE(histories->counters.get(libataxx::Side::White, a) == libataxx::Move::nomove());
+    histories->counters.update(libataxx::Side::White, a, c);
+    REQUIRE(histories->counters.get(libataxx::Side::White, a) == c);
+
+    // Most recent first, repeats don't push the other killer out
+    histories->killers.update(5, a);
+    histories->killers.update(5, b);
+    histories->killers.update(5, b);
+    REQUIRE(histories->killers.get(5)[0] == b);
+    REQUIRE(histories->killers.get(5)[1] == a);
+    histories->killers.update(5, c);
+    REQUIRE(histories->killers.get(5)[0] == c);
+    REQUIRE(histories->killers.get(5)[1] == b);
+
+    histories->clear();
+    REQUIRE(histories->butterfly.get(libataxx::Side::Black, a) == 0);
+    REQUIRE(histories->continuation.get(a, b) == 0);
+    REQUIRE(histories->counters.get(libataxx::Side::White, a) == libataxx::Move::nomove());
+    REQUIRE(histories->killers.get(5)[0] == libataxx::Move::nomove());
+}
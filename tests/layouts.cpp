@@ -0,0 +1,35 @@
+#include <libataxx/position.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include "../examples/layouts.hpp"
+#include "catch.hpp"
+
+// Gaps that FlipV leaves alone look the same from both sides' stones
+[[nodiscard]] bool fair(const libataxx::Bitboard &gaps) noexcept {
+    return libataxx::transform(gaps, libataxx::Transform::FlipV) == gaps;
+}
+
+TEST_CASE("Opening layouts") {
+    // FlipV swaps the sides' starting squares
+    const libataxx::Position startpos{"startpos"};
+    REQUIRE(libataxx::transform(startpos.get_black(), libataxx::Transform::FlipV) == startpos.get_white());
+
+    for (const int max_gaps : {0, 4, 8, 12}) {
+        std::mt19937_64 rng(max_gaps);
+        const auto layouts = random_layouts(200, max_gaps, rng);
+        REQUIRE(!layouts.empty());
+        for (const auto &gaps : layouts) {
+            REQUIRE(gaps.count() <= max_gaps);
+            REQUIRE(!(gaps & corners));
+            REQUIRE(fair(gaps));
+        }
+
+        for (const auto &gaps : symmetric_layouts(max_gaps)) {
+            REQUIRE(fair(gaps));
+        }
+    }
+
+    // Rot180 pairs up squares next to the same side's corners
+    const libataxx::Bitboard b6{libataxx::Square{1, 5}};
+    REQUIRE(!fair(b6 | libataxx::transform(b6, libataxx::Transform::Rot180)));
+}
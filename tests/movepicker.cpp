@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <libataxx/movepicker.hpp>
+#include <libataxx/position.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+[[nodiscard]] std::vector<libataxx::Move> pick_all(const libataxx::Position &pos,
+                                                   const libataxx::Move tt_move,
+                                                   const libataxx::search::Histories *histories = nullptr,
+                                                   const libataxx::Move prev = libataxx::Move::nomove(),
+                                                   const int ply = 0) {
+    std::vector<libataxx::Move> moves;
+    libataxx::search::MovePicker picker{pos, tt_move, histories, prev, ply};
+    for (auto move = picker.next(); move != libataxx::Move::nomove(); move = picker.next()) {
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+}  // namespace
+
+TEST_CASE("search::MovePicker - Every legal move once") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1",
+        "7/7/7/7/-------/-------/x5o x 0 1",
+        "7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1",
+        "x5o/7/7/7/7/7/o5x o 0 1",
+    };
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        auto expected = pos.legal_moves();
+
+        for (const auto &tt_move : {libataxx::Move::nomove(), expected.back(), libataxx::Move::from_uai("a1a3")}) {
+            auto moves = pick_all(pos, tt_move);
+            REQUIRE(moves.size() == expected.size());
+
+            const auto by_value = [](const libataxx::Move &a, const libataxx::Move &b) {
+                const auto key = [](const libataxx::Move &m) {
+                    return 256 * static_cast<int>(m.from()) + static_cast<int>(m.to());
+                };
+                return key(a) < key(b);
+            };
+            std::sort(moves.begin(), moves.end(), by_value);
+            std::sort(expected.begin(), expected.end(), by_value);
+            REQUIRE(moves == expected);
+        }
+    }
+}
+
+TEST_CASE("search::MovePicker - TT move first") {
+    const libataxx::Position pos{"3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1"};
+    for (const auto &tt_move : pos.legal_moves()) {
+        REQUIRE(pick_all(pos, tt_move).front() == tt_move);
+    }
+}
+
+TEST_CASE("search::MovePicker - Capture ordering") {
+    const libataxx::Position pos{"3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1"};
+    const auto moves = pick_all(pos, libataxx::Move::nomove());
+
+    // Captures first, most stones flipped first, singles break ties
+    int last = 1000;
+    bool captures = true;
+    for (const auto &move : moves) {
+        const int flips = pos.count_captures(move);
+        const int score = 2 * flips + move.is_single();
+        if (flips == 0) {
+            captures = false;
+            continue;
+        }
+        REQUIRE(captures);
+        REQUIRE(score <= last);
+        last = score;
+    }
+}
+
+TEST_CASE("search::MovePicker - Quiet ordering") {
+    const libataxx::Position pos{"x5o/7/7/7/7/7/o5x x 0 1"};
+    const auto is_single = [](const libataxx::Move &move) { return move.is_single(); };
+    auto histories = std::make_unique<libataxx::search::Histories>();
+
+    // Singles come before doubles whatever their history
+    histories->butterfly.update(libataxx::Side::Black, libataxx::Move::from_uai("a7c5"), 1000);
+    histories->butterfly.update(libataxx::Side::Black, libataxx::Move::from_uai("b6"), 500);
+    auto moves = pick_all(pos, libataxx::Move::nomove(), histories.get());
+    REQUIRE(moves.size() == 16);
+    REQUIRE(moves[0] == libataxx::Move::from_uai("b6"));
+    REQUIRE(std::is_partitioned(moves.begin(), moves.end(), is_single));
+    REQUIRE(*std::find_if_not(moves.begin(), moves.end(), is_single) == libataxx::Move::from_uai("a7c5"));
+
+    // Continuation history from the previous move adds to the butterfly score
+    histories->continuation.update(libataxx::Move::from_uai("f6"), libataxx::Move::from_uai("f2"), 1000);
+    moves = pick_all(pos, libataxx::Move::nomove(), histories.get(), libataxx::Move::from_uai("f6"));
+    REQUIRE(moves[0] == libataxx::Move::from_uai("f2"));
+    REQUIRE(moves[1] == libataxx::Move::from_uai("b6"));
+
+    // Killers then the counter move go ahead of everything else quiet
+    histories->killers.update(3, libataxx::Move::from_uai("g1e3"));
+    histories->killers.update(3, libataxx::Move::from_uai("a7a5"));
+    const auto counter = libataxx::Move::from_uai("g1e1");
+    histories->counters.update(libataxx::Side::Black, libataxx::Move::from_uai("f6"), counter);
+    moves = pick_all(pos, libataxx::Move::nomove(), histories.get(), libataxx::Move::from_uai("f6"), 3);
+    REQUIRE(moves[0] == libataxx::Move::from_uai("a7a5"));
+    REQUIRE(moves[1] == libataxx::Move::from_uai("g1e3"));
+    REQUIRE(moves[2] == counter);
+    REQUIRE(moves[3] == libataxx::Move::from_uai("f2"));
+}
+
+TEST_CASE("search::MovePicker - Forced pass") {
+    const libataxx::Position pos{"7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1"};
+    REQUIRE(pos.must_pass());
+    const auto moves = pick_all(pos, libataxx::Move::nomove());
+    REQUIRE(moves.size() == 1);
+    REQUIRE(moves.front() == libataxx::Move::nullmove());
+}
@@ -0,0 +1,92 @@
+#include <array>
+#include <libataxx/packed_position.hpp>
+#include <libataxx/position.hpp>
+#include <string>
+#include <unordered_set>
+#include "catch.hpp"
+
+namespace {
+
+void round_trip(const libataxx::Position &pos, const int depth, std::unordered_set<libataxx::PackedPosition> &seen) {
+    const auto packed = libataxx::PackedPosition{pos};
+    const auto unpacked = packed.unpack();
+    REQUIRE(unpacked.get_fen() == pos.get_fen());
+    REQUIRE(unpacked.get_hash() == pos.get_hash());
+    REQUIRE(packed.get_black() == pos.get_black());
+    REQUIRE(packed.get_white() == pos.get_white());
+    REQUIRE(packed.get_gaps() == pos.get_gaps());
+    REQUIRE(libataxx::PackedPosition{unpacked} == packed);
+    seen.insert(packed);
+
+    if (depth == 0) {
+        return;
+    }
+
+    for (const auto &move : pos.legal_moves()) {
+        round_trip(pos.after_move(move), depth - 1, seen);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("PackedPosition - Round trip") {
+    const std::array<std::string, 6> fens = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "x-1-1-o/-1-1-1-/1-1-1-1/-1-1-1-/1-1-1-1/-1-1-1-/o-1-1-x x 0 1",
+        "7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1",
+        "ooooooo/ooooooo/ooooooo/ooooooo/ooooooo/ooooooo/oooooox o 99 1000",
+        "-------/-------/-------/-------/-------/-------/------x o 511 1048575",
+    };
+
+    for (const auto &fen : fens) {
+        REQUIRE(libataxx::Position::from_fen(fen));
+        std::unordered_set<libataxx::PackedPosition> seen;
+        round_trip(libataxx::Position{fen}, 2, seen);
+    }
+}
+
+TEST_CASE("PackedPosition - Keys") {
+    const libataxx::Position pos{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1"};
+    const auto packed = libataxx::PackedPosition{pos};
+
+    // Every part of the position changes the key
+    const std::array<libataxx::Position, 4> others = {
+        libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1"},
+        libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x x 1 1"},
+        libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 2"},
+        libataxx::Position{"o5x/7/2-1-2/7/2-1-2/7/x5o x 0 1"},
+    };
+    for (const auto &other : others) {
+        const auto key = libataxx::PackedPosition{other};
+        REQUIRE(key != packed);
+        REQUIRE(key.hash() != packed.hash());
+        REQUIRE((key < packed || packed < key));
+    }
+    REQUIRE(libataxx::PackedPosition{pos} == packed);
+    REQUIRE(std::hash<libataxx::PackedPosition>{}(packed) == packed.hash());
+
+    // Counters that don't fit are saturated
+    const libataxx::Position long_game{"x5o/7/7/7/7/7/o5x x 600 2000000"};
+    REQUIRE(long_game.get_halfmoves() == 600);
+    const auto big = libataxx::PackedPosition{long_game};
+    REQUIRE(big.get_halfmoves() == libataxx::PackedPosition::max_halfmoves);
+    REQUIRE(big.get_fullmoves() == libataxx::PackedPosition::max_fullmoves);
+    REQUIRE(big.get_turn() == libataxx::Side::Black);
+}
+
+TEST_CASE("PackedPosition - Distinct positions") {
+    std::unordered_set<libataxx::PackedPosition> seen;
+    std::unordered_set<std::uint64_t> hashes;
+    const libataxx::Position pos{"x5o/7/7/7/7/7/o5x x 0 1"};
+
+    for (const auto &a : pos.legal_moves()) {
+        const auto apos = pos.after_move(a);
+        for (const auto &b : apos.legal_moves()) {
+            const auto bpos = apos.after_move(b);
+            seen.insert(libataxx::PackedPosition{bpos});
+            hashes.insert(bpos.get_hash());
+        }
+    }
+    REQUIRE(seen.size() == hashes.size());
+}
@@ -0,0 +1,96 @@
+#include <libataxx/position.hpp>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+// Makes every move and asks the position about it
+void reference(const libataxx::Position &pos, const int depth, libataxx::PerftStats *stats) {
+    if (depth == 0 || pos.is_gameover()) {
+        return;
+    }
+
+    for (const auto &move : pos.legal_moves()) {
+        stats->nodes++;
+        if (move == libataxx::Move::nullmove()) {
+            REQUIRE(pos.must_pass());
+            stats->passes++;
+        } else if (move.type() == libataxx::Move::Type::Single) {
+            stats->singles++;
+        } else {
+            stats->doubles++;
+        }
+        if (move != libataxx::Move::nullmove() && pos.is_capture(move)) {
+            stats->captures++;
+            stats->flips += pos.count_captures(move);
+        }
+
+        const auto npos = pos.after_move(move);
+        if (npos.is_gameover()) {
+            stats->gameovers++;
+            switch (npos.get_result()) {
+                case libataxx::Result::BlackWin:
+                    stats->black_wins++;
+                    break;
+                case libataxx::Result::WhiteWin:
+                    stats->white_wins++;
+                    break;
+                case libataxx::Result::Draw:
+                    stats->draws++;
+                    break;
+                default:
+                    FAIL("Gameover without a result");
+            }
+        }
+
+        reference(npos, depth - 1, stats + 1);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Position::perft_stats()") {
+    const std::pair<std::string, int> positions[] = {
+        {"x5o/7/7/7/7/7/o5x x 0 1", 4},
+        {"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1", 4},
+        {"7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1", 5},
+        {"7/7/7/7/-------/-------/x5o x 0 1", 6},
+        {"7/7/7/2x1o2/7/7/7 x 0 1", 3},
+        {"x5o/7/7/7/7/7/o5x x 98 1", 4},
+        {"x2-o1o/x2-1o1/3-1oo/-------/xx1-xxo/xxx-xx1/2x-3 x 98 20", 3},
+        {"ooooooo/ooooooo/xxx-oxx/xx---xx/xxx-xxx/xooxxx1/ooxxxxx o 0 60", 6},
+        {"ooooooo/ooooooo/xxx-oxx/xx---xx/xxx-xxx/xooxxx1/ooxxxxx o 99 60", 4},
+        {"xxxxxxx/xxxxxxx/xxxxxxx/xxxxxxx/xxxxxxx/xxxxxx1/oooooo1 o 0 1", 3},
+        {"o5x/7/7/7/7/7/7 x 0 1", 3},
+        {"7/7/7/7/7/7/7 x 0 1", 2},
+        {"4--o/4---/4---/7/---4/---4/x1-4 x 0 1", 2},
+    };
+
+    for (const auto &[fen, depth] : positions) {
+        INFO(fen);
+        const libataxx::Position pos{fen};
+        const auto stats = pos.perft_stats(depth);
+        REQUIRE(stats.size() == static_cast<std::size_t>(depth));
+
+        std::vector<libataxx::PerftStats> expected(depth);
+        reference(pos, depth, expected.data());
+
+        for (int i = 0; i < depth; ++i) {
+            INFO("ply " << i + 1);
+            REQUIRE(stats[i].nodes == pos.perft(i + 1));
+            REQUIRE(stats[i].nodes == expected[i].nodes);
+            REQUIRE(stats[i].singles == expected[i].singles);
+            REQUIRE(stats[i].doubles == expected[i].doubles);
+            REQUIRE(stats[i].passes == expected[i].passes);
+            REQUIRE(stats[i].captures == expected[i].captures);
+            REQUIRE(stats[i].flips == expected[i].flips);
+            REQUIRE(stats[i].gameovers == expected[i].gameovers);
+            REQUIRE(stats[i].black_wins == expected[i].black_wins);
+            REQUIRE(stats[i].white_wins == expected[i].white_wins);
+            REQUIRE(stats[i].draws == expected[i].draws);
+        }
+    }
+
+    REQUIRE(libataxx::Position{"startpos"}.perft_stats(0).empty());
+}
@@ -0,0 +1,42 @@
+#include <cstdint>
+#include <fstream>
+#include <libataxx/position.hpp>
+#include <sstream>
+#include <string>
+#include "catch.hpp"
+
+// Depths with more nodes than this are left to the perftsuite example
+constexpr std::uint64_t node_limit = 1000000;
+
+TEST_CASE("Position::perft() suite") {
+    std::ifstream fs(LIBATAXX_PERFT_EPD);
+    REQUIRE(fs.is_open());
+
+    int positions = 0;
+    std::string line;
+    while (std::getline(fs, line)) {
+        const auto semicolon = line.find(';');
+        if (line.empty() || line[0] == '#' || semicolon == std::string::npos) {
+            continue;
+        }
+
+        const auto fen = line.substr(0, semicolon);
+        const auto pos = libataxx::Position::from_fen(fen);
+        REQUIRE(pos);
+
+        std::stringstream ss{line.substr(semicolon)};
+        std::string field;
+        std::uint64_t nodes = 0;
+        int depth = 1;
+        while (ss >> field >> nodes && nodes <= node_limit) {
+            INFO(fen << " depth " << depth);
+            REQUIRE(field == ";D" + std::to_string(depth));
+            REQUIRE(pos->perft(depth) == nodes);
+            depth++;
+        }
+
+        positions++;
+    }
+
+    REQUIRE(positions >= 300);
+}
@@ -96,3 +96,90 @@ TEST_CASE("PGN - 2") {
 
     REQUIRE(ss.str() == expected);
 }
+
+TEST_CASE("PGN - Read") {
+    const std::string pgns[] = {
+        "[Event \"PGN Test\"]\n"
+        "[FEN \"x5o/7/7/7/7/7/o5x x 0 1\"]\n"
+        "[Black \"PlayerBlack\"]\n"
+        "[White \"PlayerWhite\"]\n"
+        "[Result \"*\"]\n"
+        "\n"
+        " *\n"
+        "\n",
+        "[Event \"PGN Test\"]\n"
+        "[FEN \"x5o/7/7/7/7/7/o5x x 0 1\"]\n"
+        "[Black \"PlayerBlack\"]\n"
+        "[White \"PlayerWhite\"]\n"
+        "[Result \"*\"]\n"
+        "\n"
+        "1. g2 { Test comment } 1... a2 2. g3 a3 (2... b2 { Alternate line } 3. "
+        "g4 a3 { done }) 3. g4 *\n"
+        "\n",
+        "[Event \"PGN Test\"]\n"
+        "[FEN \"x5o/7/7/7/7/7/o5x o 0 1\"]\n"
+        "[Black \"PlayerBlack\"]\n"
+        "[White \"PlayerWhite\"]\n"
+        "[Result \"*\"]\n"
+        "\n"
+        "1... a2 2. g2 *\n"
+        "\n",
+    };
+
+    // One game at a time
+    for (const auto &str : pgns) {
+        std::stringstream in{str};
+        const auto pgn = libataxx::pgn::read(in);
+        REQUIRE(pgn);
+        REQUIRE(!libataxx::pgn::read(in));
+
+        std::stringstream out;
+        out << *pgn;
+        REQUIRE(out.str() == str);
+    }
+
+    // Several games in one stream
+    std::stringstream in{pgns[0] + pgns[1] + pgns[2]};
+    for (const auto &str : pgns) {
+        const auto pgn = libataxx::pgn::read(in);
+        REQUIRE(pgn);
+        std::stringstream out;
+        out << *pgn;
+        REQUIRE(out.str() == str);
+    }
+    REQUIRE(!libataxx::pgn::read(in));
+}
+
+TEST_CASE("PGN - Read mainline") {
+    std::stringstream in{
+        "[FEN \"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1\"]\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1.f2 $1 a1c1!? 2. f1 0000 1-0\n"};
+
+    const auto pgn = libataxx::pgn::read(in);
+    REQUIRE(pgn);
+    REQUIRE(libataxx::pgn::get_result(*pgn) == libataxx::Result::WhiteWin);
+    REQUIRE(libataxx::pgn::start_position(*pgn).get_fen() == "x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1");
+
+    const std::vector<libataxx::Move> expected = {
+        libataxx::Move::from_uai("f2"),
+        libataxx::Move::from_uai("a1c1"),
+        libataxx::Move::from_uai("f1"),
+        libataxx::Move::nullmove(),
+    };
+    REQUIRE(pgn->root().mainline() == expected);
+
+    // Copies keep their own parent pointers
+    const auto copy = *pgn;
+    const auto *node = &copy.root();
+    while (node->has_children()) {
+        REQUIRE(node->children().front().parent() == node);
+        node = &node->children().front();
+    }
+}
+
+TEST_CASE("PGN - Read invalid") {
+    std::stringstream in{"1. g2 h9 *"};
+    REQUIRE_THROWS(libataxx::pgn::read(in));
+}
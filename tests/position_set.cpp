@@ -0,0 +1,212 @@
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <filesystem>
+#include <libataxx/board.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/position_set.hpp>
+#include <libataxx/symmetry.hpp>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+[[nodiscard]] std::vector<libataxx::Position> positions(const int depth) {
+    std::vector<libataxx::Position> result;
+    std::vector<libataxx::Position> frontier = {libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x x 0 1"}};
+
+    for (int i = 0; i < depth; ++i) {
+        std::vector<libataxx::Position> next;
+        for (const auto &pos : frontier) {
+            for (const auto &move : pos.legal_moves()) {
+                next.push_back(pos.after_move(move));
+            }
+        }
+        result.insert(result.end(), next.begin(), next.end());
+        frontier = next;
+    }
+
+    return result;
+}
+
+[[nodiscard]] std::uint64_t count_unique(const std::vector<libataxx::Position> &list) {
+    std::vector<std::uint64_t> keys;
+    for (const auto &pos : list) {
+        keys.push_back(libataxx::canonical_hash(pos));
+    }
+    std::sort(keys.begin(), keys.end());
+    return std::unique(keys.begin(), keys.end()) - keys.begin();
+}
+
+}  // namespace
+
+TEST_CASE("canonical_hash()") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1",
+        "4o2/2x1o2/2x4/1o5/7/3o1oo/-x3-1 o 0 1",
+    };
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        const auto symmetries = pos.get_symmetries();
+        REQUIRE(libataxx::has_symmetry(symmetries, libataxx::canonical(pos).second));
+
+        for (const auto t : libataxx::transforms) {
+            const auto npos = libataxx::transform(pos, t);
+            REQUIRE(libataxx::canonical_hash(npos, libataxx::all_symmetries) ==
+                    libataxx::canonical_hash(pos, libataxx::all_symmetries));
+            // Only transforms that keep the gaps in place are tried by default
+            if (libataxx::has_symmetry(symmetries, t)) {
+                REQUIRE(npos.get_gaps() == pos.get_gaps());
+                REQUIRE(libataxx::canonical_hash(npos) == libataxx::canonical_hash(pos));
+            }
+            REQUIRE(libataxx::transform(npos, libataxx::inverse(t)).get_fen() == pos.get_fen());
+
+            // Moves follow the board
+            for (const auto &move : pos.legal_moves()) {
+                const auto nmove = libataxx::transform(move, t);
+                REQUIRE(npos.is_legal_move(nmove));
+                REQUIRE(libataxx::transform(pos.after_move(move), t).get_hash() == npos.after_move(nmove).get_hash());
+            }
+        }
+    }
+}
+
+TEST_CASE("Position::get_symmetries()") {
+    const std::pair<std::string, std::size_t> tests[] = {
+        {"x5o/7/7/7/7/7/o5x x 0 1", 8},
+        {"x5o/7/7/-------/7/7/o5x x 0 1", 4},
+        {"x-4o/-6/7/7/7/7/o5x x 0 1", 2},
+        {"4o2/2x1o2/2x4/1o5/7/3o1oo/-x3-1 o 0 1", 1},
+    };
+
+    for (const auto &[fen, count] : tests) {
+        const libataxx::Position pos{fen};
+        const auto symmetries = pos.get_symmetries();
+        REQUIRE(static_cast<std::size_t>(std::popcount(symmetries)) == count);
+        for (const auto t : libataxx::transforms) {
+            REQUIRE(libataxx::has_symmetry(symmetries, t) ==
+                    (libataxx::transform(pos.get_gaps(), t) == pos.get_gaps()));
+        }
+        REQUIRE(libataxx::Board{pos}.symmetry_mask() == symmetries);
+
+        // Without symmetries there's nothing to compare against
+        if (count == 1) {
+            REQUIRE(pos.get_minimal_hash() == pos.get_hash());
+            REQUIRE(libataxx::canonical_hash(pos) == pos.get_hash());
+        }
+
+        // Every result is the hash of a position with the same gaps
+        for (const auto &move : pos.legal_moves()) {
+            const auto npos = pos.after_move(move);
+            const auto minimal = npos.get_minimal_hash();
+            REQUIRE(minimal == npos.get_minimal_hash(symmetries));
+            bool found = false;
+            for (const auto t : libataxx::transforms) {
+                const auto tpos = libataxx::transform(npos, t);
+                found |= tpos.get_gaps() == npos.get_gaps() && tpos.get_hash() == minimal;
+            }
+            REQUIRE(found);
+        }
+    }
+}
+
+TEST_CASE("PositionSet") {
+    const auto list = positions(3);
+    const auto expected = count_unique(list);
+    REQUIRE(expected < list.size());
+
+    libataxx::PositionSet set;
+    std::uint64_t inserted = 0;
+    for (const auto &pos : list) {
+        inserted += set.insert(pos);
+    }
+    REQUIRE(inserted == expected);
+    REQUIRE(set.size() == expected);
+
+    for (const auto &pos : list) {
+        REQUIRE(set.contains(pos));
+        REQUIRE(set.contains(libataxx::transform(pos, libataxx::Transform::FlipV)));
+    }
+    REQUIRE(!set.contains(libataxx::Position{"7/7/7/7/7/7/7 x 0 1"}));
+}
+
+TEST_CASE("PositionSet - Concurrent inserts") {
+    const auto list = positions(3);
+    const auto expected = count_unique(list);
+
+    for (const bool spill : {false, true}) {
+        libataxx::PositionSetOptions options;
+        options.shards = 4;
+        options.bloom = spill;
+        options.bloom_bits = 1 << 16;
+        options.max_memory_keys = spill ? 400 : 0;
+        options.spill_directory = std::filesystem::temp_directory_path().string();
+
+        libataxx::PositionSet set{options};
+        std::atomic<std::uint64_t> inserted = 0;
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(t);
+                auto shuffled = list;
+                std::shuffle(shuffled.begin(), shuffled.end(), rng);
+                for (const auto &pos : shuffled) {
+                    inserted += set.insert(pos);
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        REQUIRE(inserted == expected);
+        REQUIRE(set.size() == expected);
+        REQUIRE((set.spilled() > 0) == spill);
+        for (const auto &pos : list) {
+            REQUIRE(set.contains(pos));
+        }
+    }
+}
+
+TEST_CASE("PositionSet - Merging spilled keys") {
+    const auto dir = std::filesystem::temp_directory_path() / ("positionset-merge-" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+
+    for (const std::size_t max_runs : {1U, 3U, 8U}) {
+        libataxx::PositionSetOptions options;
+        options.shards = 2;
+        options.max_memory_keys = 20;
+        options.max_runs = max_runs;
+        options.spill_directory = dir.string();
+
+        libataxx::PositionSet set{options};
+        std::mt19937_64 rng(max_runs);
+        std::vector<std::uint64_t> keys(3000);
+        for (auto &key : keys) {
+            key = rng() | 1;
+            REQUIRE(set.insert_key(key));
+        }
+
+        const auto files = std::distance(std::filesystem::directory_iterator{dir}, {});
+        REQUIRE(set.spilled() > 0);
+        REQUIRE(files > 0);
+        REQUIRE(files <= static_cast<std::ptrdiff_t>(2 * max_runs));
+
+        for (const auto key : keys) {
+            REQUIRE(set.contains_key(key));
+            REQUIRE(!set.insert_key(key));
+        }
+        REQUIRE(!set.contains_key(2));
+        REQUIRE(set.size() == keys.size());
+    }
+
+    REQUIRE(std::filesystem::is_empty(dir));
+    std::filesystem::remove(dir);
+}
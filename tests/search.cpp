@@ -0,0 +1,275 @@
+#include <atomic>
+#include <libataxx/mcts.hpp>
+#include <libataxx/position.hpp>
+#include <libataxx/search.hpp>
+#include <string>
+#include <thread>
+#include "catch.hpp"
+
+TEST_CASE("search::Search - Legal moves") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1",
+        "7/7/7/7/-------/-------/x5o x 0 1",
+        "7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1",
+    };
+
+    libataxx::search::Search search{1};
+    libataxx::search::Limits limits;
+    limits.depth = 3;
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        const auto result = search.go(pos, limits);
+        REQUIRE(pos.is_legal_move(result.bestmove));
+        REQUIRE(result.depth == 3);
+        REQUIRE(!result.pv.empty());
+        REQUIRE(result.pv.front() == result.bestmove);
+        REQUIRE(result.nodes > 0);
+    }
+}
+
+TEST_CASE("search::Search - Captures") {
+    // Every stone can be won with a single move
+    const libataxx::Position pos{"7/7/7/7/3x3/ooo4/o1o4 x 0 1"};
+    libataxx::search::Search search{1};
+    libataxx::search::Limits limits;
+    limits.depth = 1;
+    REQUIRE(search.go(pos, limits).bestmove == libataxx::Move::from_uai("d3b1"));
+}
+
+TEST_CASE("search::Search - Game over") {
+    const libataxx::Position pos{"7/7/7/7/7/7/x6 x 0 1"};
+    libataxx::search::Search search{1};
+    REQUIRE(search.go(pos, {}).bestmove == libataxx::Move::nomove());
+}
+
+TEST_CASE("search::Search - Win") {
+    const libataxx::Position pos{"7/7/7/7/3x3/ooo4/o1o4 x 0 1"};
+    libataxx::search::Search search{1};
+    libataxx::search::Limits limits;
+    limits.depth = 4;
+    const auto result = search.go(pos, limits);
+    REQUIRE(result.score == libataxx::search::mate_score - 1);
+}
+
+TEST_CASE("search::Search - Node limit") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::search::Search search{1};
+    libataxx::search::Limits limits;
+    limits.nodes = 5000;
+    const auto result = search.go(pos, limits);
+    REQUIRE(pos.is_legal_move(result.bestmove));
+    REQUIRE(result.nodes <= 5000 + 1024);
+}
+
+TEST_CASE("search::Search - Pruning") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "3xx-1/-2ooxx/2oo1o1/1-xoo2/1-4o/x4-1/1x2xx1 x 0 1",
+        "7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1",
+        "7/7/7/7/ooooooo/ooooooo/xxxxxx1 o 0 1",
+    };
+
+    libataxx::search::Search pruned{1};
+    libataxx::search::Search plain{1};
+    plain.set_params(libataxx::search::no_pruning());
+    libataxx::search::Limits limits;
+    limits.depth = 6;
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        pruned.clear();
+        plain.clear();
+        const auto a = pruned.go(pos, limits);
+        const auto b = plain.go(pos, limits);
+        REQUIRE(pos.is_legal_move(a.bestmove));
+        REQUIRE(a.depth == 6);
+        REQUIRE(a.nodes <= b.nodes);
+    }
+
+    // Forced passes are searched rather than pruned
+    const libataxx::Position pass{"7/7/7/7/ooooooo/ooooooo/xxxxxxx x 0 1"};
+    REQUIRE(pruned.go(pass, limits).bestmove == libataxx::Move::nullmove());
+
+    // The win is still found
+    const libataxx::Position win{"7/7/7/7/3x3/ooo4/o1o4 x 0 1"};
+    REQUIRE(pruned.go(win, limits).score == libataxx::search::mate_score - 1);
+
+    // Reductions at the lowest depths the parameters allow
+    libataxx::search::Params params;
+    REQUIRE(libataxx::search::set_param(params, "LMRDepth", 1));
+    pruned.set_params(params);
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        REQUIRE(pos.is_legal_move(pruned.go(pos, limits).bestmove));
+    }
+}
+
+TEST_CASE("search::set_param") {
+    libataxx::search::Params params;
+    REQUIRE(libataxx::search::set_param(params, "NMPReduction", 2));
+    REQUIRE(params.nmp_reduction == 2);
+    REQUIRE(libataxx::search::set_param(params, "RazorMargin", 100000));
+    REQUIRE(params.razor_margin == 2000);
+    REQUIRE(!libataxx::search::set_param(params, "Nothing", 1));
+}
+
+TEST_CASE("search::Search - Ponderhit") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::search::Search search{1};
+    libataxx::search::Result result;
+
+    // No limits until the ponderhit
+    std::thread thread([&]() { result = search.go(pos, {}); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto t0 = std::chrono::steady_clock::now();
+    search.ponderhit({std::chrono::milliseconds(10), std::chrono::milliseconds(50)});
+    thread.join();
+
+    REQUIRE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(1000));
+    REQUIRE(pos.is_legal_move(result.bestmove));
+}
+
+TEST_CASE("mcts::MCTS") {
+    const std::string fens[] = {
+        "x5o/7/7/7/7/7/o5x x 0 1",
+        "x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1",
+        "7/7/7/7/-------/-------/x5o x 0 1",
+    };
+
+    libataxx::mcts::MCTS mcts;
+    libataxx::search::Limits limits;
+    limits.nodes = 500;
+
+    for (const auto &fen : fens) {
+        const libataxx::Position pos{fen};
+        const auto result = mcts.go(pos, limits);
+        REQUIRE(pos.is_legal_move(result.bestmove));
+        REQUIRE(result.nodes == 500);
+    }
+
+    // Take everything
+    const libataxx::Position pos{"7/7/7/7/3x3/ooo4/o1o4 x 0 1"};
+    REQUIRE(mcts.go(pos, limits).bestmove == libataxx::Move::from_uai("d3b1"));
+    REQUIRE(mcts.reused() == 0);
+}
+
+TEST_CASE("mcts::MCTS - Tree reuse") {
+    libataxx::mcts::MCTS mcts;
+    libataxx::search::Limits limits;
+    limits.nodes = 2000;
+
+    // Two plies down the principal variation
+    auto pos = libataxx::Position{"startpos"};
+    auto result = mcts.go(pos, limits);
+    REQUIRE(result.pv.size() >= 2);
+    pos.makemove(result.pv[0]);
+    pos.makemove(result.pv[1]);
+
+    limits.nodes = 100;
+    result = mcts.go(pos, limits);
+    REQUIRE(mcts.reused() > 0);
+    REQUIRE(pos.is_legal_move(result.bestmove));
+    REQUIRE(result.nodes == 100);
+
+    // One ply down
+    pos.makemove(result.bestmove);
+    result = mcts.go(pos, limits);
+    REQUIRE(mcts.reused() > 0);
+    REQUIRE(pos.is_legal_move(result.bestmove));
+
+    // Nowhere in the tree
+    result = mcts.go(libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1"}, limits);
+    REQUIRE(mcts.reused() == 0);
+
+    // Cleared
+    mcts.clear();
+    result = mcts.go(libataxx::Position{"x5o/7/2-1-2/7/2-1-2/7/o5x o 0 1"}, limits);
+    REQUIRE(mcts.reused() == 0);
+}
+
+TEST_CASE("mcts::MCTS - Node budget") {
+    libataxx::mcts::MCTS mcts{1.4f, 1000};
+    libataxx::search::Limits limits;
+    limits.nodes = 5000;
+
+    // Iterations carry on once the tree is full
+    auto pos = libataxx::Position{"startpos"};
+    auto result = mcts.go(pos, limits);
+    REQUIRE(mcts.size() <= 1000);
+    REQUIRE(result.nodes == 5000);
+    REQUIRE(pos.is_legal_move(result.bestmove));
+
+    // The reused subtree leaves room to grow again
+    pos.makemove(result.bestmove);
+    result = mcts.go(pos, limits);
+    REQUIRE(mcts.size() <= 1000);
+    REQUIRE(pos.is_legal_move(result.bestmove));
+}
+
+TEST_CASE("search::Search - Ponderhit before go") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::search::Search search{1};
+
+    const auto t0 = std::chrono::steady_clock::now();
+    search.ponderhit({std::chrono::milliseconds(10), std::chrono::milliseconds(50)});
+    const auto result = search.go(pos, {});
+
+    REQUIRE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(1000));
+    REQUIRE(pos.is_legal_move(result.bestmove));
+}
+
+TEST_CASE("mcts::MCTS - Ponderhit") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::mcts::MCTS mcts;
+    libataxx::search::Result result;
+
+    std::thread thread([&]() { result = mcts.go(pos, {}); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto t0 = std::chrono::steady_clock::now();
+    mcts.ponderhit({std::chrono::milliseconds(10), std::chrono::milliseconds(50)});
+    thread.join();
+
+    REQUIRE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(1000));
+    REQUIRE(pos.is_legal_move(result.bestmove));
+}
+
+TEST_CASE("mcts::MCTS - Ponderhit before go") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::mcts::MCTS mcts;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    mcts.ponderhit({std::chrono::milliseconds(10), std::chrono::milliseconds(50)});
+    const auto result = mcts.go(pos, {});
+
+    REQUIRE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(1000));
+    REQUIRE(pos.is_legal_move(result.bestmove));
+}
+
+TEST_CASE("mcts::MCTS - Stopped before searching") {
+    const libataxx::Position pos{"startpos"};
+    libataxx::mcts::MCTS mcts;
+
+    // A stop only counts once the search is running, so keep sending it from
+    // before go() the way the UAI driver does. Any of these searches can stop
+    // before the root is expanded
+    for (int i = 0; i < 200; ++i) {
+        mcts.clear();
+        std::atomic<bool> done = false;
+        std::thread stopper([&]() {
+            while (!done) {
+                mcts.stop();
+            }
+        });
+        const auto result = mcts.go(pos, {});
+        done = true;
+        stopper.join();
+
+        REQUIRE(pos.is_legal_move(result.bestmove));
+        REQUIRE(result.lines.size() == 1);
+        REQUIRE(result.lines[0].move == result.bestmove);
+    }
+}
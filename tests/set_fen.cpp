@@ -0,0 +1,81 @@
+#include <libataxx/fen.hpp>
+#include <libataxx/position.hpp>
+#include <string>
+#include "catch.hpp"
+
+TEST_CASE("Position::set_fen() lenient forms") {
+    const std::pair<std::string, std::string> tests[] = {
+        {"startpos", "x5o/7/7/7/7/7/o5x x 0 1"},
+        {"  startpos\n", "x5o/7/7/7/7/7/o5x x 0 1"},
+        {"x5o/7/7/7/7/7/o5x/ x 0 1", "x5o/7/7/7/7/7/o5x x 0 1"},
+        {"X5O/7/7/7/7/7/O5X X 0 1", "x5o/7/7/7/7/7/o5x x 0 1"},
+        {"b5w/7/7/7/7/7/w5b w 0 1", "x5o/7/7/7/7/7/o5x o 0 1"},
+        {"x5o/7/7/7/7/7/o5x  O  12  34 ", "x5o/7/7/7/7/7/o5x o 12 34"},
+        {"x5o/7/7/7/7/7/o5x\tx\t3\t4", "x5o/7/7/7/7/7/o5x x 3 4"},
+        {"x1o1x1o/-6/7/3-3/7/6-/o1x1o1x o 99 100", "x1o1x1o/-6/7/3-3/7/6-/o1x1o1x o 99 100"},
+    };
+
+    for (const auto &[fen, expected] : tests) {
+        INFO(fen);
+        libataxx::Position pos;
+        REQUIRE(pos.set_fen(fen) == libataxx::FenError::None);
+        REQUIRE(pos.get_fen() == expected);
+        REQUIRE(pos.get_hash() == pos.calculate_hash());
+    }
+}
+
+TEST_CASE("Position::set_fen() errors") {
+    const std::pair<std::string, libataxx::FenError> tests[] = {
+        {"", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/7/7/7", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/7/7/7/o5x/7 x 0 1", libataxx::FenError::InvalidBoard},
+        {"x6o/7/7/7/7/7/o5x x 0 1", libataxx::FenError::InvalidBoard},
+        {"x4o/7/7/7/7/7/o5x x 0 1", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/7/7/7/o8 x 0 1", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/0/7/7/o5x x 0 1", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/7/7/7/o5z x 0 1", libataxx::FenError::InvalidBoard},
+        {"x5o7/7/7/7/7/7/o5x x 0 1", libataxx::FenError::InvalidBoard},
+        {"x5o/7/7/7/7/7/o5x - 0 1", libataxx::FenError::InvalidTurn},
+        {"x5o/7/7/7/7/7/o5x xo 0 1", libataxx::FenError::InvalidTurn},
+        {"x5o/7/7/7/7/7/o5x x -1 1", libataxx::FenError::InvalidHalfmoves},
+        {"x5o/7/7/7/7/7/o5x x 1a 1", libataxx::FenError::InvalidHalfmoves},
+        {"x5o/7/7/7/7/7/o5x x 0 99999999999", libataxx::FenError::InvalidFullmoves},
+        {"x5o/7/7/7/7/7/o5x x 0 1 extra", libataxx::FenError::TrailingCharacters},
+    };
+
+    for (const auto &[fen, error] : tests) {
+        INFO(fen);
+        libataxx::Position pos{"x5o/7/2-1-2/7/2-1-2/7/o5x o 5 6"};
+        const auto before = pos.get_fen();
+        REQUIRE(pos.set_fen(fen) == error);
+        REQUIRE(pos.get_fen() == before);
+        REQUIRE(!libataxx::Position::from_fen(fen));
+    }
+}
+
+TEST_CASE("fen::parse_lines()") {
+    // Enough lines for four threads with blocks of uneven size, small buffers
+    // are parsed on one thread
+    std::string buffer;
+    for (int i = 0; i < 30001; ++i) {
+        buffer += i % 3 == 0 ? "x5o/7/7/7/7/7/o5x x 0 " + std::to_string(i + 1) + "\r\n" : "";
+        buffer += i % 3 == 1 ? "\n   \n" : "";
+        buffer += i % 3 == 2 ? "bad fen\n" : "";
+    }
+
+    for (const unsigned int threads : {1U, 4U}) {
+        const auto results = libataxx::fen::parse_lines(buffer, threads);
+        REQUIRE(results.size() == 20001);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            if (i % 2 == 0) {
+                REQUIRE(results[i]);
+                REQUIRE(results[i]->get_fullmoves() == 3 * (i / 2) + 1);
+            } else {
+                REQUIRE(!results[i]);
+            }
+        }
+    }
+
+    REQUIRE(libataxx::fen::parse_lines("").empty());
+    REQUIRE(libataxx::fen::parse_lines("startpos").size() == 1);
+}
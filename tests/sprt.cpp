@@ -0,0 +1,113 @@
+#include <cmath>
+#include <libataxx/sprt.hpp>
+#include "catch.hpp"
+
+using namespace libataxx::sprt;
+
+TEST_CASE("sprt::score_to_elo()") {
+    REQUIRE(score_to_elo(0.5) == Approx(0.0).margin(1e-9));
+    REQUIRE(score_to_elo(0.75) == Approx(190.85).epsilon(1e-3));
+    REQUIRE(score_to_elo(0.25) == Approx(-190.85).epsilon(1e-3));
+    REQUIRE(std::isinf(score_to_elo(1.0)));
+
+    for (const double elo : {-300.0, -10.0, 0.0, 5.0, 120.0}) {
+        REQUIRE(score_to_elo(elo_to_score(elo)) == Approx(elo).margin(1e-9));
+    }
+}
+
+TEST_CASE("sprt::Pentanomial") {
+    Pentanomial penta;
+    REQUIRE(penta.pairs() == 0);
+    REQUIRE(penta.mean() == 0.5);
+    REQUIRE(los(penta) == 0.5);
+    REQUIRE(elo(penta).elo == 0.0);
+
+    penta.add(4);
+    penta.add(2);
+    penta.add(2);
+    penta.add(0);
+    REQUIRE(penta.pairs() == 4);
+    REQUIRE(penta.mean() == 0.5);
+    REQUIRE(penta.variance() == Approx(0.125));
+    REQUIRE(elo(penta).elo == Approx(0.0).margin(1e-9));
+    REQUIRE(elo(penta).error > 0.0);
+    REQUIRE(los(penta) == Approx(0.5));
+
+    penta.add(3);
+    penta.add(3);
+    REQUIRE(penta.mean() > 0.5);
+    REQUIRE(elo(penta).elo > 0.0);
+    REQUIRE(los(penta) > 0.5);
+}
+
+TEST_CASE("sprt::Elo error shrinks") {
+    Pentanomial small;
+    Pentanomial large;
+    for (int i = 0; i < 10; ++i) {
+        for (const int points : {1, 2, 2, 3, 3}) {
+            small.add(points);
+            for (int j = 0; j < 100; ++j) {
+                large.add(points);
+            }
+        }
+    }
+
+    REQUIRE(elo(small).elo == Approx(elo(large).elo));
+    REQUIRE(elo(large).error < elo(small).error / 5);
+}
+
+TEST_CASE("sprt::SPRT") {
+    SECTION("Bounds") {
+        const SPRT sprt{0.0, 5.0, 0.05, 0.05};
+        REQUIRE(sprt.lower_bound() == Approx(-2.944).epsilon(1e-3));
+        REQUIRE(sprt.upper_bound() == Approx(2.944).epsilon(1e-3));
+        REQUIRE(sprt.status() == Status::Continue);
+        REQUIRE(sprt.llr() == 0.0);
+    }
+
+    SECTION("Close to the normal approximation") {
+        SPRT sprt{0.0, 5.0};
+        const int counts[5] = {100, 500, 1000, 600, 150};
+        for (int i = 0; i < 5; ++i) {
+            for (int j = 0; j < counts[i]; ++j) {
+                sprt.add(i);
+            }
+        }
+        REQUIRE(sprt.llr() == Approx(5.40).epsilon(0.01));
+        REQUIRE(sprt.status() == Status::AcceptH1);
+    }
+
+    SECTION("Stronger engine accepts H1") {
+        SPRT sprt{0.0, 10.0};
+        auto status = Status::Continue;
+        for (int i = 0; i < 100000 && status == Status::Continue; ++i) {
+            // 58% expected score, around 56 Elo
+            status = sprt.add(i % 5 == 0 ? 1 : i % 5 == 4 ? 2 : i % 2 ? 3 : 2);
+        }
+        REQUIRE(status == Status::AcceptH1);
+        REQUIRE(sprt.llr() >= sprt.upper_bound());
+    }
+
+    SECTION("Equal engines accept H0") {
+        SPRT sprt{5.0, 10.0};
+        auto status = Status::Continue;
+        for (int i = 0; i < 100000 && status == Status::Continue; ++i) {
+            status = sprt.add(i % 4 == 0 ? 1 : i % 4 == 1 ? 3 : 2);
+        }
+        REQUIRE(status == Status::AcceptH0);
+        REQUIRE(sprt.llr() <= sprt.lower_bound());
+        REQUIRE(sprt.pentanomial().mean() == Approx(0.5).margin(1e-3));
+    }
+
+    SECTION("One sided results conclude") {
+        SPRT sprt{0.0, 50.0};
+        auto status = Status::Continue;
+        for (int i = 0; i < 1000 && status == Status::Continue; ++i) {
+            status = sprt.add(4);
+        }
+        REQUIRE(status == Status::AcceptH1);
+        REQUIRE(sprt.pentanomial().pairs() < 100);
+        REQUIRE(std::isinf(elo(sprt.pentanomial()).elo));
+        REQUIRE(std::isinf(elo(sprt.pentanomial()).error));
+    }
+}
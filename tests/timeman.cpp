@@ -0,0 +1,88 @@
+#include <chrono>
+#include <libataxx/position.hpp>
+#include <libataxx/timeman.hpp>
+#include <thread>
+#include "catch.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("timeman::expected_moves") {
+    const libataxx::timeman::Policy policy;
+    const libataxx::timeman::Clock clock{10000ms, 0ms, 0};
+
+    // Fewer empties leave fewer moves
+    const libataxx::Position start{"startpos"};
+    const libataxx::Position late{"xxxxxxx/ooooooo/xxxxxxx/ooooooo/xxxx3/o6/7 x 0 1"};
+    REQUIRE(libataxx::timeman::expected_moves(clock, start, policy) == policy.max_movestogo);
+    REQUIRE(libataxx::timeman::expected_moves(clock, late, policy) < policy.max_movestogo);
+    REQUIRE(libataxx::timeman::expected_moves(clock, late, policy) >= policy.min_movestogo);
+
+    // Movestogo is used unless the board fills up first
+    REQUIRE(libataxx::timeman::expected_moves({10000ms, 0ms, 5}, start, policy) == 5);
+    REQUIRE(libataxx::timeman::expected_moves({10000ms, 0ms, 50}, late, policy) ==
+            libataxx::timeman::expected_moves(clock, late, policy));
+}
+
+TEST_CASE("timeman::allocate") {
+    const libataxx::Position pos{"startpos"};
+
+    REQUIRE(libataxx::timeman::allocate({}, pos).soft.count() == 0);
+    REQUIRE(libataxx::timeman::allocate({}, pos).hard.count() == 0);
+
+    for (const auto time : {10ms, 100ms, 1000ms, 10000ms, 100000ms}) {
+        for (const auto inc : {0ms, 10ms, 1000ms}) {
+            for (const int movestogo : {0, 1, 2, 40}) {
+                const auto allocation = libataxx::timeman::allocate({time, inc, movestogo}, pos);
+                REQUIRE(allocation.soft.count() > 0);
+                REQUIRE(allocation.soft <= allocation.hard);
+                REQUIRE(allocation.hard <= std::max(1ms, time - 30ms));
+            }
+        }
+    }
+
+    // More time, more to spend
+    const auto a = libataxx::timeman::allocate({1000ms, 0ms, 0}, pos);
+    const auto b = libataxx::timeman::allocate({2000ms, 0ms, 0}, pos);
+    const auto c = libataxx::timeman::allocate({1000ms, 100ms, 0}, pos);
+    REQUIRE(a.soft < b.soft);
+    REQUIRE(a.soft < c.soft);
+}
+
+TEST_CASE("timeman::TimeManager") {
+    const libataxx::timeman::Allocation allocation{100ms, 300ms};
+    const auto a = libataxx::Move::from_uai("f1");
+    const auto b = libataxx::Move::from_uai("g2");
+
+    // A stable best move shrinks the soft limit
+    libataxx::timeman::TimeManager stable{allocation};
+    stable.start();
+    for (int depth = 1; depth <= 8; ++depth) {
+        stable.update(depth, a, 100);
+    }
+    REQUIRE(stable.scale() < 1.0);
+
+    // A changing best move and a falling score stretch it
+    libataxx::timeman::TimeManager unstable{allocation};
+    unstable.start();
+    unstable.update(1, a, 100);
+    unstable.update(2, b, -100);
+    REQUIRE(unstable.scale() > 1.5);
+    REQUIRE(unstable.should_continue());
+
+    // The clock is only read every check_interval nodes
+    libataxx::timeman::Policy policy;
+    policy.check_interval = 1000;
+    libataxx::timeman::TimeManager tm{libataxx::timeman::Allocation{1ms, 1ms}, policy};
+    tm.start();
+    std::this_thread::sleep_for(5ms);
+    REQUIRE(!tm.should_stop(999));
+    REQUIRE(tm.should_stop(1000));
+    REQUIRE(tm.should_stop(1001));
+    REQUIRE(!tm.should_continue());
+
+    // No limits
+    libataxx::timeman::TimeManager unlimited;
+    unlimited.start();
+    REQUIRE(!unlimited.should_stop(1000000));
+    REQUIRE(unlimited.should_continue());
+}
@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <chrono>
+#include <libataxx/uai.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+
+namespace {
+
+[[nodiscard]] std::vector<std::string> lines(const std::stringstream &ss) {
+    std::vector<std::string> result;
+    std::stringstream in{ss.str()};
+    std::string line;
+    while (std::getline(in, line)) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+[[nodiscard]] bool starts_with(const std::string &str, const std::string &prefix) {
+    return str.rfind(prefix, 0) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("UAI - parse_go()") {
+    const auto params =
+        libataxx::uai::parse_go("go btime 1000 wtime 2000 binc 10 winc 20 movestogo 5 depth 3 nodes 400");
+    REQUIRE(params.btime.count() == 1000);
+    REQUIRE(params.wtime.count() == 2000);
+    REQUIRE(params.binc.count() == 10);
+    REQUIRE(params.winc.count() == 20);
+    REQUIRE(params.movestogo == 5);
+    REQUIRE(params.depth == 3);
+    REQUIRE(params.nodes == 400);
+    REQUIRE(!params.infinite);
+    REQUIRE(!params.ponder);
+
+    REQUIRE(libataxx::uai::parse_go("go infinite").infinite);
+    REQUIRE(libataxx::uai::parse_go("go ponder movetime 50").ponder);
+    REQUIRE(libataxx::uai::parse_go("go ponder movetime 50").movetime.count() == 50);
+}
+
+TEST_CASE("UAI - default_time_manager()") {
+    const libataxx::Position black{"startpos"};
+    const libataxx::Position white{"x5o/7/7/7/7/7/o5x o 0 1"};
+
+    const auto none = libataxx::uai::default_time_manager(libataxx::uai::parse_go("go"), black);
+    REQUIRE(none.soft.count() == 0);
+    REQUIRE(none.hard.count() == 0);
+
+    const auto movetime = libataxx::uai::default_time_manager(libataxx::uai::parse_go("go movetime 123"), black);
+    REQUIRE(movetime.soft.count() == 123);
+    REQUIRE(movetime.hard.count() == 123);
+
+    const auto params = libataxx::uai::parse_go("go btime 3000 wtime 6000 binc 100 winc 200 movestogo 10");
+    REQUIRE(libataxx::uai::default_time_manager(params, black).soft.count() == 350);
+    REQUIRE(libataxx::uai::default_time_manager(params, white).soft.count() == 700);
+    REQUIRE(libataxx::uai::default_time_manager(params, black).hard.count() == 1050);
+
+    // Never more than what's left on the clock
+    const auto low = libataxx::uai::parse_go("go btime 40 binc 1000");
+    REQUIRE(libataxx::uai::default_time_manager(low, black).soft.count() <= 40);
+    REQUIRE(libataxx::uai::default_time_manager(low, black).hard.count() <= 40);
+}
+
+TEST_CASE("UAI - format_info()") {
+    libataxx::search::Info info;
+    info.depth = 3;
+    info.score = -200;
+    info.nodes = 5000;
+    info.time = std::chrono::milliseconds(10);
+    info.pv = {libataxx::Move::from_uai("g2"), libataxx::Move::from_uai("a1c3")};
+    REQUIRE(libataxx::uai::format_info(info) == "info depth 3 score cp -200 nodes 5000 nps 500000 time 10 pv g2 a1c3");
+
+    info.score = libataxx::search::mate_score - 3;
+    REQUIRE(starts_with(libataxx::uai::format_info(info), "info depth 3 score mate 2 "));
+    info.score = -libataxx::search::mate_score + 4;
+    REQUIRE(starts_with(libataxx::uai::format_info(info), "info depth 3 score mate -2 "));
+
+    info.multipv = 2;
+    REQUIRE(starts_with(libataxx::uai::format_info(info), "info depth 3 multipv 2 score mate -2 "));
+}
+
+TEST_CASE("UAI - Driver") {
+    libataxx::uai::SearchEngine engine;
+    std::stringstream in;
+    std::stringstream out;
+    libataxx::uai::Driver driver{engine, in, out};
+
+    REQUIRE(driver.handle("uai"));
+    REQUIRE(driver.handle("isready"));
+    REQUIRE(driver.handle("setoption name Hash value 2"));
+    REQUIRE(driver.handle("setoption name LMRDepth value 4"));
+    REQUIRE(driver.handle("setoption name Ponder value true"));
+    REQUIRE(driver.handle("uainewgame"));
+
+    REQUIRE(driver.handle("position fen x5o/7/7/7/7/7/o5x o 0 1"));
+    REQUIRE(driver.position().get_fen() == "x5o/7/7/7/7/7/o5x o 0 1");
+    REQUIRE(driver.handle("position startpos moves g2 a2"));
+    REQUIRE(driver.position().get_fen() == "x5o/7/7/7/7/o5x/o5x x 0 2");
+
+    REQUIRE(driver.handle("go depth 3"));
+    driver.wait();
+
+    const auto output = lines(out);
+    REQUIRE(output.at(0) == "id name libataxx");
+    REQUIRE(output.at(1) == "id author kz04px");
+    REQUIRE(output.at(2) == "option name Hash type spin default 16 min 1 max 4096");
+
+    REQUIRE(output.at(3) == "option name Ponder type check default false");
+    REQUIRE(output.at(4) == "option name MultiPV type spin default 1 min 1 max 64");
+
+    // Search parameters follow
+    constexpr std::size_t n = libataxx::search::param_info.size() + 2;
+    REQUIRE(output.at(5) == "option name NMPDepth type spin default 3 min 0 max 32");
+    REQUIRE(output.at(3 + n) == "uaiok");
+    REQUIRE(output.at(4 + n) == "readyok");
+    REQUIRE(starts_with(output.at(5 + n), "info depth 1 "));
+    REQUIRE(starts_with(output.at(6 + n), "info depth 2 "));
+    REQUIRE(starts_with(output.at(7 + n), "info depth 3 "));
+    REQUIRE(starts_with(output.at(8 + n), "bestmove "));
+    REQUIRE(output.size() == 9 + n);
+
+    const auto &bestmove = output.at(8 + n);
+    const auto move = libataxx::Move::from_uai(bestmove.substr(9, bestmove.find(' ', 9) - 9));
+    REQUIRE(driver.position().is_legal_move(move));
+
+    REQUIRE(!driver.handle("quit"));
+}
+
+TEST_CASE("UAI - Driver errors") {
+    libataxx::uai::SearchEngine engine;
+    std::stringstream in;
+    std::stringstream out;
+    libataxx::uai::Driver driver{engine, in, out};
+
+    REQUIRE(driver.handle("position fen 8/7/7/7/7/7/7 x 0 1"));
+    REQUIRE(driver.handle("position startpos moves g2 g3"));
+    REQUIRE(driver.position().get_fen() == "x5o/7/7/7/7/6x/o5x o 0 1");
+
+    const auto output = lines(out);
+    REQUIRE(output.size() == 2);
+    REQUIRE(starts_with(output.at(0), "info string Invalid FEN"));
+    REQUIRE(starts_with(output.at(1), "info string Illegal move g3"));
+}
+
+TEST_CASE("UAI - Driver stop") {
+    libataxx::uai::SearchEngine engine;
+    std::stringstream in;
+    std::stringstream out;
+    libataxx::uai::Driver driver{engine, in, out};
+
+    // Infinite and ponder searches only answer after stop or ponderhit
+    for (const auto &go : {"go infinite", "go ponder wtime 100 btime 100"}) {
+        out.str("");
+        REQUIRE(driver.handle("position startpos"));
+        REQUIRE(driver.handle(go));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(driver.handle("isready"));
+        REQUIRE(driver.handle(std::string(go) == "go infinite" ? "stop" : "ponderhit"));
+        driver.wait();
+
+        const auto output = lines(out);
+        REQUIRE(std::count(output.begin(), output.end(), "readyok") == 1);
+        REQUIRE(starts_with(output.back(), "bestmove "));
+    }
+
+    // Stopping straight after go still gives a move
+    for (int i = 0; i < 20; ++i) {
+        out.str("");
+        REQUIRE(driver.handle("go infinite"));
+        REQUIRE(driver.handle("stop"));
+        driver.wait();
+        REQUIRE(starts_with(lines(out).back(), "bestmove "));
+    }
+
+    // Time controls
+    out.str("");
+    const auto t0 = std::chrono::steady_clock::now();
+    REQUIRE(driver.handle("go movetime 50"));
+    driver.wait();
+    REQUIRE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(1000));
+    REQUIRE(starts_with(lines(out).back(), "bestmove "));
+}
+
+TEST_CASE("UAI - Driver ponderhit") {
+    libataxx::uai::SearchEngine search;
+    libataxx::uai::MCTSEngine mcts;
+
+    libataxx::uai::Engine *engines[] = {&search, &mcts};
+
+    for (auto *engine : engines) {
+        std::stringstream in;
+        std::stringstream out;
+        libataxx::uai::Driver driver{*engine, in, out};
+
+        // A ponder search only keeps time once the ponder move is played
+        REQUIRE(driver.handle("position startpos moves f1"));
+        REQUIRE(driver.handle("go ponder wtime 1000 btime 1000"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto t0 = std::chrono::steady_clock::now();
+        REQUIRE(driver.handle("ponderhit"));
+        driver.wait();
+        const auto dt = std::chrono::steady_clock::now() - t0;
+
+        const auto hard = libataxx::uai::default_time_manager(libataxx::uai::parse_go("go wtime 1000 btime 1000"),
+                                                              driver.position())
+                              .hard;
+        REQUIRE(dt < hard + std::chrono::milliseconds(100));
+        REQUIRE(starts_with(lines(out).back(), "bestmove "));
+
+        // A ponder miss is stopped and searched again
+        out.str("");
+        REQUIRE(driver.handle("go ponder wtime 1000 btime 1000"));
+        REQUIRE(driver.handle("stop"));
+        driver.wait();
+        REQUIRE(driver.handle("position startpos moves f1 b6"));
+        REQUIRE(driver.handle("go movetime 20"));
+        driver.wait();
+        const auto output = lines(out);
+        REQUIRE(std::count_if(output.begin(), output.end(), [](const auto &line) {
+                    return starts_with(line, "bestmove ");
+                }) == 2);
+    }
+}
+
+TEST_CASE("UAI - Driver run") {
+    libataxx::uai::SearchEngine engine;
+    std::stringstream in{"uai\nposition startpos\ngo depth 2\nisready\nquit\n"};
+    std::stringstream out;
+    {
+        libataxx::uai::Driver driver{engine, in, out};
+        driver.run();
+    }
+
+    const auto output = lines(out);
+    REQUIRE(std::count(output.begin(), output.end(), "uaiok") == 1);
+    REQUIRE(std::count(output.begin(), output.end(), "readyok") == 1);
+    REQUIRE(std::count_if(output.begin(), output.end(), [](const auto &line) {
+                return starts_with(line, "bestmove ");
+            }) == 1);
+}